@@ -0,0 +1,330 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <platform/config.hpp>
+
+#include <kodoc/kodoc.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/chrono.hpp>
+
+// Use boost::chrono to get a high-precision clock on all platforms
+// Note: std::chrono seems to have insufficient precision on Windows
+namespace bc = boost::chrono;
+
+/// @example kodoc_latency.cpp
+///
+/// Measures the latency of every kodoc_write_payload() and
+/// kodoc_read_payload() call and reports the latency distribution for each
+/// rank of the decoder. This shows how the cost of a single packet grows
+/// as the decoder approaches full rank, which is hidden when only the
+/// total time of a generation is measured.
+
+/// A histogram with a bounded relative error, in the style of an HDR
+/// histogram. The values are grouped in power-of-two ranges, and every
+/// range is split into the same number of linear sub-buckets, so a recorded
+/// value is off by at most 1 / sub_buckets of its own magnitude. Recording
+/// is a few shifts and an increment, so it does not disturb the
+/// measurement.
+class latency_histogram
+{
+public:
+
+    /// The number of linear sub-buckets in every power-of-two range
+    static const uint32_t sub_bucket_bits = 7;
+    static const uint32_t sub_buckets = 1U << sub_bucket_bits;
+
+    latency_histogram() :
+        m_counts((64 - sub_bucket_bits + 1) * sub_buckets, 0),
+        m_total(0),
+        m_max(0)
+    { }
+
+    void record(uint64_t value)
+    {
+        ++m_counts[index(value)];
+        ++m_total;
+        m_max = std::max(m_max, value);
+    }
+
+    /// @return The number of recorded values
+    uint64_t count() const
+    {
+        return m_total;
+    }
+
+    /// @return The largest recorded value
+    uint64_t max() const
+    {
+        return m_max;
+    }
+
+    /// @param p The percentile (0.0 < p <= 100.0)
+    /// @return The lowest value that is larger than or equal to p percent of
+    ///         the recorded values. The value is the upper bound of the
+    ///         bucket that contains the percentile, capped by max().
+    uint64_t percentile(double p) const
+    {
+        if (m_total == 0)
+            return 0;
+
+        uint64_t rank = (uint64_t)(p / 100.0 * m_total + 0.999999);
+        rank = std::max<uint64_t>(rank, 1);
+
+        uint64_t seen = 0;
+        for (uint32_t i = 0; i < m_counts.size(); ++i)
+        {
+            seen += m_counts[i];
+            if (seen >= rank)
+                return std::min(upper_bound(i), m_max);
+        }
+        return m_max;
+    }
+
+private:
+
+    static uint32_t index(uint64_t value)
+    {
+        // Values below sub_buckets are stored exactly in the first range
+        if (value < sub_buckets)
+            return (uint32_t) value;
+
+        uint32_t magnitude = 63 - leading_zeros(value);
+        uint32_t shift = magnitude - sub_bucket_bits + 1;
+        uint32_t range = shift;
+
+        // The top bit is implied by the range, so the sub-bucket is given
+        // by the next sub_bucket_bits - 1 bits
+        uint32_t sub_bucket = (uint32_t)(value >> shift) - sub_buckets / 2;
+
+        return sub_buckets + (range - 1) * (sub_buckets / 2) + sub_bucket;
+    }
+
+    static uint64_t upper_bound(uint32_t index)
+    {
+        if (index < sub_buckets)
+            return index;
+
+        uint32_t offset = index - sub_buckets;
+        uint32_t range = offset / (sub_buckets / 2) + 1;
+        uint64_t sub_bucket = offset % (sub_buckets / 2) + sub_buckets / 2;
+
+        return ((sub_bucket + 1) << range) - 1;
+    }
+
+    static uint32_t leading_zeros(uint64_t value)
+    {
+        uint32_t zeros = 0;
+        for (uint64_t bit = 1ULL << 63; (value & bit) == 0; bit >>= 1)
+            ++zeros;
+        return zeros;
+    }
+
+private:
+
+    std::vector<uint64_t> m_counts;
+    uint64_t m_total;
+    uint64_t m_max;
+};
+
+/// The latency histograms for a single rank of the decoder
+struct rank_latency
+{
+    latency_histogram encode;
+    latency_histogram decode;
+};
+
+static uint64_t elapsed_nanoseconds(bc::high_resolution_clock::time_point start,
+                                    bc::high_resolution_clock::time_point stop)
+{
+    return bc::duration_cast<bc::nanoseconds>(stop - start).count();
+}
+
+// Encodes and decodes a single generation and records the latency of every
+// payload under the rank that the decoder had before reading it.
+//
+// @param encoder_factory The factory used to build the encoder
+// @param decoder_factory The factory used to build the decoder
+// @param systematic Whether the encoder sends the source symbols first
+// @param latencies The histograms for every rank of the decoder
+// @return true if the data was decoded correctly
+static bool run_generation(kodoc_factory_t encoder_factory,
+                           kodoc_factory_t decoder_factory,
+                           bool systematic,
+                           std::vector<rank_latency>& latencies)
+{
+    kodoc_coder_t encoder = kodoc_factory_build_coder(encoder_factory);
+    kodoc_coder_t decoder = kodoc_factory_build_coder(decoder_factory);
+
+    if (kodoc_has_systematic_interface(encoder))
+    {
+        if (systematic)
+            kodoc_set_systematic_on(encoder);
+        else
+            kodoc_set_systematic_off(encoder);
+    }
+
+    uint32_t block_size = kodoc_block_size(encoder);
+    std::vector<uint8_t> data_in(block_size);
+    std::vector<uint8_t> data_out(block_size, 0);
+
+    for (auto& e : data_in)
+        e = rand() % 256;
+
+    kodoc_set_const_symbols(encoder, data_in.data(), block_size);
+    kodoc_set_mutable_symbols(decoder, data_out.data(), block_size);
+
+    std::vector<uint8_t> payload(kodoc_payload_size(encoder));
+
+    bc::high_resolution_clock::time_point start, stop;
+
+    while (!kodoc_is_complete(decoder))
+    {
+        uint32_t rank = kodoc_rank(decoder);
+
+        start = bc::high_resolution_clock::now();
+        kodoc_write_payload(encoder, payload.data());
+        stop = bc::high_resolution_clock::now();
+
+        latencies[rank].encode.record(elapsed_nanoseconds(start, stop));
+
+        start = bc::high_resolution_clock::now();
+        kodoc_read_payload(decoder, payload.data());
+        stop = bc::high_resolution_clock::now();
+
+        latencies[rank].decode.record(elapsed_nanoseconds(start, stop));
+    }
+
+    bool success = memcmp(data_in.data(), data_out.data(), block_size) == 0;
+
+    kodoc_delete_coder(encoder);
+    kodoc_delete_coder(decoder);
+
+    return success;
+}
+
+static void print_latency(const latency_histogram& h)
+{
+    printf("%llu,%llu,%llu,%llu",
+           (unsigned long long) h.percentile(50.0),
+           (unsigned long long) h.percentile(99.0),
+           (unsigned long long) h.percentile(99.9),
+           (unsigned long long) h.max());
+}
+
+// The main function should not be defined on Windows Phone
+#if !defined(PLATFORM_WINDOWS_PHONE)
+int main(int argc, const char* argv[])
+{
+    if (argc < 4 || argc > 6)
+    {
+        printf("Usage: %s [binary|binary4|binary8] "
+               "symbols symbol_size {generations=1000} {systematic=0}\n",
+               argv[0]);
+        return 1;
+    }
+
+    // Here we select the finite field to use
+    int32_t field;
+    if (strcmp(argv[1], "binary") == 0)
+    {
+        field = kodoc_binary;
+    }
+    else if (strcmp(argv[1], "binary4") == 0)
+    {
+        field = kodoc_binary4;
+    }
+    else if (strcmp(argv[1], "binary8") == 0)
+    {
+        field = kodoc_binary8;
+    }
+    else
+    {
+        printf("Invalid finite field: %s\n", argv[1]);
+        return 1;
+    }
+
+    uint32_t symbols = atoi(argv[2]);
+    uint32_t symbol_size = atoi(argv[3]);
+
+    uint32_t generations = 1000;
+    if (argc >= 5)
+    {
+        generations = atoi(argv[4]);
+    }
+
+    bool systematic = false;
+    if (argc >= 6)
+    {
+        systematic = atoi(argv[5]) != 0;
+    }
+
+    // Set the random seed to randomize encoded data
+    srand((uint32_t)time(NULL));
+
+    // Here we select the codec we wish to use
+    int32_t codec = kodoc_full_vector;
+
+    kodoc_factory_t encoder_factory =
+        kodoc_new_encoder_factory(codec, field, symbols, symbol_size);
+
+    kodoc_factory_t decoder_factory =
+        kodoc_new_decoder_factory(codec, field, symbols, symbol_size);
+
+    std::vector<rank_latency> latencies(symbols);
+
+    bool decoding_success = true;
+
+    for (uint32_t i = 0; i < generations; ++i)
+    {
+        decoding_success &= run_generation(
+            encoder_factory, decoder_factory, systematic, latencies);
+    }
+
+    printf("Generations: %u / Symbols: %u / Symbol_size: %u / "
+           "Systematic: %s\n", generations, symbols, symbol_size,
+           systematic ? "on" : "off");
+    printf("All latencies are in nanoseconds\n\n");
+
+    // Report the latencies for every rank the decoder had before reading
+    // a payload. The last rows show the cost of the final decoding steps.
+    printf("rank,payloads,"
+           "encode_p50,encode_p99,encode_p99.9,encode_max,"
+           "decode_p50,decode_p99,decode_p99.9,decode_max\n");
+
+    for (uint32_t rank = 0; rank < symbols; ++rank)
+    {
+        const rank_latency& l = latencies[rank];
+
+        printf("%u,%llu,", rank, (unsigned long long) l.decode.count());
+        print_latency(l.encode);
+        printf(",");
+        print_latency(l.decode);
+        printf("\n");
+    }
+
+    kodoc_delete_factory(encoder_factory);
+    kodoc_delete_factory(decoder_factory);
+
+    if (decoding_success)
+    {
+        printf("\nAll data decoded correctly.\n");
+    }
+    else
+    {
+        printf("\nDecoding failed.\n");
+    }
+
+    return 0;
+}
+#endif
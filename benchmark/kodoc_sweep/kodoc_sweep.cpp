@@ -0,0 +1,630 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <platform/config.hpp>
+
+#include <kodoc/kodoc.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <boost/chrono.hpp>
+
+// Use boost::chrono to get a high-precision clock on all platforms
+// Note: std::chrono seems to have insufficient precision on Windows
+namespace bc = boost::chrono;
+
+/// @example kodoc_sweep.cpp
+///
+/// Measures the coding throughput of every available codec over a grid of
+/// finite fields, symbols and symbol sizes, with the systematic mode on and
+/// off, and for a range of densities (sparse codecs) and width ratios
+/// (perpetual). Every point of the grid is measured several times and the
+/// median and the 90th and 99th percentiles of the samples are written as
+/// CSV or JSON.
+
+struct codec_name
+{
+    const char* name;
+    int32_t codec;
+};
+
+static const codec_name codec_names[] =
+    {
+        {"full_vector", kodoc_full_vector},
+        {"on_the_fly", kodoc_on_the_fly},
+        {"sliding_window", kodoc_sliding_window},
+        {"sparse_full_vector", kodoc_sparse_full_vector},
+        {"seed", kodoc_seed},
+        {"sparse_seed", kodoc_sparse_seed},
+        {"perpetual", kodoc_perpetual},
+        {"fulcrum", kodoc_fulcrum},
+        {"reed_solomon", kodoc_reed_solomon}
+    };
+
+static const char* field_names[] = {"binary", "binary4", "binary8"};
+
+/// A single point of the parameter grid
+struct sweep_point
+{
+    int32_t codec;
+    int32_t field;
+    uint32_t symbols;
+    uint32_t symbol_size;
+    bool systematic;
+    // The density of sparse codecs, or 0 if not applicable
+    double density;
+    // The width ratio of the perpetual codec, or 0 if not applicable
+    double width_ratio;
+};
+
+/// The measurements of a single run
+struct run_result
+{
+    bool success;
+    double setup_time;
+    double encoding_rate;
+    double decoding_rate;
+    double overhead;
+};
+
+/// The distribution of the samples of a metric
+struct summary
+{
+    double median;
+    double p90;
+    double p99;
+};
+
+/// The options given on the command line
+struct options
+{
+    std::vector<int32_t> codecs;
+    std::vector<int32_t> fields;
+    std::vector<uint32_t> symbols;
+    std::vector<uint32_t> symbol_sizes;
+    std::vector<double> densities;
+    std::vector<double> width_ratios;
+    uint32_t runs;
+    bool json;
+    std::string output;
+};
+
+static const char* codec_to_string(int32_t codec)
+{
+    for (const auto& c : codec_names)
+    {
+        if (c.codec == codec)
+            return c.name;
+    }
+    return "unknown";
+}
+
+static bool parse_codec(const std::string& name, int32_t* codec)
+{
+    for (const auto& c : codec_names)
+    {
+        if (name == c.name)
+        {
+            *codec = c.codec;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool parse_field(const std::string& name, int32_t* field)
+{
+    for (int32_t i = 0; i < 3; ++i)
+    {
+        if (name == field_names[i])
+        {
+            *field = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+static std::vector<std::string> split(const std::string& list)
+{
+    std::vector<std::string> items;
+    std::string::size_type start = 0;
+
+    while (start <= list.size())
+    {
+        std::string::size_type end = list.find(',', start);
+        if (end == std::string::npos)
+            end = list.size();
+
+        if (end > start)
+            items.push_back(list.substr(start, end - start));
+
+        start = end + 1;
+    }
+    return items;
+}
+
+/// Returns the given percentile of the sorted samples using the nearest
+/// rank method
+static double percentile(const std::vector<double>& sorted, double p)
+{
+    if (sorted.empty())
+        return 0.0;
+
+    uint32_t rank = (uint32_t)(p / 100.0 * sorted.size() + 0.999999);
+    rank = std::max(rank, 1U);
+    rank = std::min(rank, (uint32_t)sorted.size());
+
+    return sorted[rank - 1];
+}
+
+static summary summarize(std::vector<double> samples)
+{
+    std::sort(samples.begin(), samples.end());
+
+    summary s;
+    s.median = percentile(samples, 50.0);
+    s.p90 = percentile(samples, 90.0);
+    s.p99 = percentile(samples, 99.0);
+    return s;
+}
+
+static double elapsed_microseconds(bc::high_resolution_clock::time_point start,
+                                   bc::high_resolution_clock::time_point stop)
+{
+    return bc::duration_cast<bc::nanoseconds>(stop - start).count() / 1000.0;
+}
+
+// Runs a timed encoding and decoding of a single block.
+//
+// @param point The parameters of the coders
+// @return The measurements of the run
+static run_result run_coding_test(const sweep_point& point)
+{
+    run_result run;
+
+    bc::high_resolution_clock::time_point start, stop;
+
+    // First, we measure the combined setup time for the encoder and decoder
+    start = bc::high_resolution_clock::now();
+
+    kodoc_factory_t encoder_factory = kodoc_new_encoder_factory(
+        point.codec, point.field, point.symbols, point.symbol_size);
+
+    kodoc_factory_t decoder_factory = kodoc_new_decoder_factory(
+        point.codec, point.field, point.symbols, point.symbol_size);
+
+    kodoc_coder_t encoder = kodoc_factory_build_coder(encoder_factory);
+    kodoc_coder_t decoder = kodoc_factory_build_coder(decoder_factory);
+
+    stop = bc::high_resolution_clock::now();
+    run.setup_time = elapsed_microseconds(start, stop);
+
+    if (kodoc_has_systematic_interface(encoder))
+    {
+        if (point.systematic)
+            kodoc_set_systematic_on(encoder);
+        else
+            kodoc_set_systematic_off(encoder);
+    }
+
+    if (point.density > 0.0)
+        kodoc_set_density(encoder, point.density);
+
+    if (point.width_ratio > 0.0)
+        kodoc_set_width_ratio(encoder, point.width_ratio);
+
+    uint32_t block_size = kodoc_block_size(encoder);
+    std::vector<uint8_t> data_in(block_size);
+    std::vector<uint8_t> data_out(block_size, 0);
+
+    for (auto& e : data_in)
+        e = rand() % 256;
+
+    kodoc_set_const_symbols(encoder, data_in.data(), block_size);
+    kodoc_set_mutable_symbols(decoder, data_out.data(), block_size);
+
+    // Payloads are generated and consumed in batches of one block. Sparse
+    // codecs and the binary field may need several batches.
+    uint32_t payload_size = kodoc_payload_size(encoder);
+    uint32_t payload_count = point.symbols;
+
+    std::vector<uint8_t> payload_buffer(payload_size * payload_count);
+    std::vector<uint8_t*> payloads(payload_count);
+
+    for (uint32_t i = 0; i < payload_count; ++i)
+        payloads[i] = &payload_buffer[i * payload_size];
+
+    double encoding_time = 0.0;
+    double decoding_time = 0.0;
+    uint64_t encoded_payloads = 0;
+    uint64_t decoded_payloads = 0;
+
+    // Give up on a configuration that does not converge, e.g. a very low
+    // density with a small field
+    uint64_t max_payloads = 100ULL * point.symbols;
+
+    while (!kodoc_is_complete(decoder) && decoded_payloads < max_payloads)
+    {
+        start = bc::high_resolution_clock::now();
+        kodoc_write_payloads(encoder, payload_buffer.data(), payload_size,
+                             payload_count, NULL);
+        stop = bc::high_resolution_clock::now();
+
+        encoding_time += elapsed_microseconds(start, stop);
+        encoded_payloads += payload_count;
+
+        start = bc::high_resolution_clock::now();
+        uint32_t used =
+            kodoc_read_payloads(decoder, payloads.data(), payload_count);
+        stop = bc::high_resolution_clock::now();
+
+        decoding_time += elapsed_microseconds(start, stop);
+        decoded_payloads += used;
+    }
+
+    // The rates are in megabytes / second (bytes / microsecond)
+    run.encoding_rate = encoded_payloads * point.symbol_size / encoding_time;
+    run.decoding_rate = (double) block_size / decoding_time;
+
+    // The number of payloads needed on top of the number of symbols
+    run.overhead = (double) decoded_payloads - point.symbols;
+
+    run.success = kodoc_is_complete(decoder) != 0 &&
+        memcmp(data_in.data(), data_out.data(), block_size) == 0;
+
+    kodoc_delete_coder(encoder);
+    kodoc_delete_coder(decoder);
+
+    kodoc_delete_factory(encoder_factory);
+    kodoc_delete_factory(decoder_factory);
+
+    return run;
+}
+
+/// @return Whether the encoders of the codec can switch the systematic mode
+static bool has_systematic_mode(int32_t codec, int32_t field)
+{
+    kodoc_factory_t factory = kodoc_new_encoder_factory(codec, field, 1, 1);
+    kodoc_coder_t encoder = kodoc_factory_build_coder(factory);
+
+    bool systematic = kodoc_has_systematic_interface(encoder) != 0;
+
+    kodoc_delete_coder(encoder);
+    kodoc_delete_factory(factory);
+
+    return systematic;
+}
+
+/// @return The points of the parameter grid for the given options
+static std::vector<sweep_point> build_grid(const options& opts)
+{
+    std::vector<sweep_point> grid;
+
+    for (int32_t codec : opts.codecs)
+    {
+        if (!kodoc_has_codec(codec))
+            continue;
+
+        // Reed-Solomon is only available in binary8
+        std::vector<int32_t> fields = opts.fields;
+        if (codec == kodoc_reed_solomon)
+        {
+            fields.clear();
+            if (std::find(opts.fields.begin(), opts.fields.end(),
+                          kodoc_binary8) != opts.fields.end())
+            {
+                fields.push_back(kodoc_binary8);
+            }
+        }
+
+        std::vector<double> densities = {0.0};
+        if (codec == kodoc_sparse_full_vector || codec == kodoc_sparse_seed)
+            densities = opts.densities;
+
+        std::vector<double> width_ratios = {0.0};
+        if (codec == kodoc_perpetual)
+            width_ratios = opts.width_ratios;
+
+        if (fields.empty())
+            continue;
+
+        // Only measure both modes if the systematic mode can be changed
+        std::vector<bool> systematic_modes = {true};
+        if (has_systematic_mode(codec, fields[0]))
+            systematic_modes.push_back(false);
+
+        for (int32_t field : fields)
+        for (uint32_t symbols : opts.symbols)
+        for (uint32_t symbol_size : opts.symbol_sizes)
+        for (double density : densities)
+        for (double width_ratio : width_ratios)
+        for (bool systematic : systematic_modes)
+        {
+            // A Reed-Solomon block cannot exceed the field size
+            if (codec == kodoc_reed_solomon && symbols > 255)
+                continue;
+
+            sweep_point point =
+                {codec, field, symbols, symbol_size, systematic, density,
+                 width_ratio};
+            grid.push_back(point);
+        }
+    }
+
+    return grid;
+}
+
+static void write_header(FILE* out, bool json)
+{
+    if (json)
+    {
+        fprintf(out, "[\n");
+        return;
+    }
+
+    fprintf(out, "codec,field,symbols,symbol_size,systematic,density,"
+                 "width_ratio,runs,failures,"
+                 "setup_us_median,setup_us_p90,setup_us_p99,"
+                 "encoding_mbps_median,encoding_mbps_p90,encoding_mbps_p99,"
+                 "decoding_mbps_median,decoding_mbps_p90,decoding_mbps_p99,"
+                 "overhead_median,overhead_p90,overhead_p99\n");
+}
+
+static void write_point(FILE* out, bool json, bool first,
+                        const sweep_point& point, uint32_t runs,
+                        uint32_t failures, const summary& setup,
+                        const summary& encoding, const summary& decoding,
+                        const summary& overhead)
+{
+    if (json)
+    {
+        fprintf(out,
+            "%s  {\"codec\": \"%s\", \"field\": \"%s\", \"symbols\": %u, "
+            "\"symbol_size\": %u, \"systematic\": %s, \"density\": %g, "
+            "\"width_ratio\": %g, \"runs\": %u, \"failures\": %u, "
+            "\"setup_us\": {\"median\": %.3f, \"p90\": %.3f, \"p99\": %.3f}, "
+            "\"encoding_mbps\": {\"median\": %.3f, \"p90\": %.3f, "
+            "\"p99\": %.3f}, "
+            "\"decoding_mbps\": {\"median\": %.3f, \"p90\": %.3f, "
+            "\"p99\": %.3f}, "
+            "\"overhead\": {\"median\": %g, \"p90\": %g, \"p99\": %g}}",
+            first ? "" : ",\n",
+            codec_to_string(point.codec), field_names[point.field],
+            point.symbols, point.symbol_size,
+            point.systematic ? "true" : "false",
+            point.density, point.width_ratio, runs, failures,
+            setup.median, setup.p90, setup.p99,
+            encoding.median, encoding.p90, encoding.p99,
+            decoding.median, decoding.p90, decoding.p99,
+            overhead.median, overhead.p90, overhead.p99);
+        return;
+    }
+
+    fprintf(out, "%s,%s,%u,%u,%d,%g,%g,%u,%u,"
+                 "%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%g,%g,%g\n",
+            codec_to_string(point.codec), field_names[point.field],
+            point.symbols, point.symbol_size, point.systematic ? 1 : 0,
+            point.density, point.width_ratio, runs, failures,
+            setup.median, setup.p90, setup.p99,
+            encoding.median, encoding.p90, encoding.p99,
+            decoding.median, decoding.p90, decoding.p99,
+            overhead.median, overhead.p90, overhead.p99);
+}
+
+static void write_footer(FILE* out, bool json)
+{
+    if (json)
+        fprintf(out, "\n]\n");
+}
+
+static void print_usage(const char* program)
+{
+    printf("Usage: %s [options]\n"
+           "  --codecs=LIST        Codecs to measure (default: all "
+           "available)\n"
+           "  --fields=LIST        Fields: binary,binary4,binary8 "
+           "(default: all)\n"
+           "  --symbols=LIST       Number of symbols "
+           "(default: 16,32,64,128,256)\n"
+           "  --symbol_sizes=LIST  Symbol sizes in bytes "
+           "(default: 64,256,1400,4096)\n"
+           "  --densities=LIST     Densities for the sparse codecs "
+           "(default: 0.1,0.3,0.5)\n"
+           "  --width_ratios=LIST  Width ratios for perpetual "
+           "(default: 0.1,0.3,0.5,1.0)\n"
+           "  --runs=N             Runs for every point (default: 20)\n"
+           "  --format=csv|json    Output format (default: csv)\n"
+           "  --output=FILE        Output file (default: stdout)\n",
+           program);
+}
+
+static bool parse_options(int argc, const char* argv[], options* opts)
+{
+    for (const auto& c : codec_names)
+        opts->codecs.push_back(c.codec);
+
+    opts->fields = {kodoc_binary, kodoc_binary4, kodoc_binary8};
+    opts->symbols = {16, 32, 64, 128, 256};
+    opts->symbol_sizes = {64, 256, 1400, 4096};
+    opts->densities = {0.1, 0.3, 0.5};
+    opts->width_ratios = {0.1, 0.3, 0.5, 1.0};
+    opts->runs = 20;
+    opts->json = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        std::string::size_type equals = arg.find('=');
+
+        if (arg.compare(0, 2, "--") != 0 || equals == std::string::npos)
+            return false;
+
+        std::string key = arg.substr(2, equals - 2);
+        std::string value = arg.substr(equals + 1);
+        std::vector<std::string> items = split(value);
+
+        if (key == "codecs")
+        {
+            opts->codecs.clear();
+            for (const auto& item : items)
+            {
+                int32_t codec;
+                if (!parse_codec(item, &codec))
+                    return false;
+                opts->codecs.push_back(codec);
+            }
+        }
+        else if (key == "fields")
+        {
+            opts->fields.clear();
+            for (const auto& item : items)
+            {
+                int32_t field;
+                if (!parse_field(item, &field))
+                    return false;
+                opts->fields.push_back(field);
+            }
+        }
+        else if (key == "symbols" || key == "symbol_sizes")
+        {
+            std::vector<uint32_t>& values =
+                key == "symbols" ? opts->symbols : opts->symbol_sizes;
+            values.clear();
+            for (const auto& item : items)
+            {
+                int value = atoi(item.c_str());
+                if (value <= 0)
+                    return false;
+                values.push_back(value);
+            }
+        }
+        else if (key == "densities" || key == "width_ratios")
+        {
+            std::vector<double>& values =
+                key == "densities" ? opts->densities : opts->width_ratios;
+            values.clear();
+            for (const auto& item : items)
+            {
+                double value = atof(item.c_str());
+                if (value <= 0.0 || value > 1.0)
+                    return false;
+                values.push_back(value);
+            }
+        }
+        else if (key == "runs")
+        {
+            int runs = atoi(value.c_str());
+            if (runs <= 0)
+                return false;
+            opts->runs = runs;
+        }
+        else if (key == "format")
+        {
+            if (value != "csv" && value != "json")
+                return false;
+            opts->json = value == "json";
+        }
+        else if (key == "output")
+        {
+            opts->output = value;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// The main function should not be defined on Windows Phone
+#if !defined(PLATFORM_WINDOWS_PHONE)
+int main(int argc, const char* argv[])
+{
+    options opts;
+    if (!parse_options(argc, argv, &opts))
+    {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    FILE* out = stdout;
+    if (!opts.output.empty())
+    {
+        out = fopen(opts.output.c_str(), "w");
+        if (out == NULL)
+        {
+            printf("Cannot open the output file: %s\n", opts.output.c_str());
+            return 1;
+        }
+    }
+
+    // Set the random seed to randomize encoded data
+    srand((uint32_t)time(NULL));
+
+    std::vector<sweep_point> grid = build_grid(opts);
+
+    write_header(out, opts.json);
+
+    bool first = true;
+    bool decoding_success = true;
+
+    for (const auto& point : grid)
+    {
+        std::vector<double> setup_time;
+        std::vector<double> encoding_rate;
+        std::vector<double> decoding_rate;
+        std::vector<double> overhead;
+        uint32_t failures = 0;
+
+        for (uint32_t i = 0; i < opts.runs; ++i)
+        {
+            run_result run = run_coding_test(point);
+
+            if (!run.success)
+            {
+                ++failures;
+                continue;
+            }
+
+            setup_time.push_back(run.setup_time);
+            encoding_rate.push_back(run.encoding_rate);
+            decoding_rate.push_back(run.decoding_rate);
+            overhead.push_back(run.overhead);
+        }
+
+        decoding_success &= failures == 0;
+
+        write_point(out, opts.json, first, point, opts.runs, failures,
+                    summarize(setup_time), summarize(encoding_rate),
+                    summarize(decoding_rate), summarize(overhead));
+        fflush(out);
+
+        first = false;
+    }
+
+    write_footer(out, opts.json);
+
+    if (out != stdout)
+        fclose(out);
+
+    if (!decoding_success)
+    {
+        fprintf(stderr, "Decoding failed for some of the runs.\n");
+        return 1;
+    }
+
+    return 0;
+}
+#endif
@@ -106,11 +106,9 @@ results run_coding_test(int32_t finite_field, uint32_t symbols,
 
     // Start the encoding timer
     start = bc::high_resolution_clock::now();
-    // Generate coded symbols with the encoder
-    for (i = 0; i < payload_count; ++i)
-    {
-        kodoc_write_payload(encoder, payloads[i]);
-    }
+    // Generate coded symbols with the encoder in a single batch
+    kodoc_write_payloads(encoder, payload_buffer, payload_size, payload_count,
+                         NULL);
     // Stop the encoding timer
     stop = bc::high_resolution_clock::now();
 
@@ -123,11 +121,8 @@ results run_coding_test(int32_t finite_field, uint32_t symbols,
 
     // Start the decoding timer
     start = bc::high_resolution_clock::now();
-    // Feed the coded symbols to the decoder
-    for (i = 0; !kodoc_is_complete(decoder) && i < payload_count; ++i)
-    {
-        kodoc_read_payload(decoder, payloads[i]);
-    }
+    // Feed the coded symbols to the decoder until it is complete
+    kodoc_read_payloads(decoder, payloads, payload_count);
     // Stop the decoding timer
     stop = bc::high_resolution_clock::now();
 
@@ -161,6 +156,112 @@ results run_coding_test(int32_t finite_field, uint32_t symbols,
     return run;
 }
 
+// Measures the recoding rate of a relay, which runs on the finite field
+// kernels that kodo-c selects for the CPU.
+//
+// @param finite_field The finite field used in the benchmark
+// @param symbols The number of original symbols in the block
+// @param symbol_size The size of a symbol in bytes
+// @return The recoding rate in megabytes / seconds
+double run_recoding_test(int32_t finite_field, uint32_t symbols,
+                         uint32_t symbol_size)
+{
+    kodoc_factory_t encoder_factory = kodoc_new_encoder_factory(
+        kodoc_full_vector, finite_field, symbols, symbol_size);
+
+    kodoc_coder_t encoder = kodoc_factory_build_coder(encoder_factory);
+
+    kodoc_relay_t relay =
+        kodoc_new_relay(finite_field, symbols, symbol_size, symbols);
+
+    uint32_t block_size = kodoc_block_size(encoder);
+    uint8_t* data_in = (uint8_t*) malloc(block_size);
+    uint8_t* symbol = (uint8_t*) malloc(symbol_size);
+    uint8_t* coefficients =
+        (uint8_t*) malloc(kodoc_relay_coefficient_vector_size(relay));
+
+    uint32_t i;
+    for (i = 0; i < block_size; ++i)
+        data_in[i] = rand() % 256;
+
+    kodoc_set_const_symbols(encoder, data_in, block_size);
+
+    // Fill the relay with coded symbols
+    for (i = 0; i < symbols; ++i)
+    {
+        kodoc_write_symbol(encoder, symbol, coefficients);
+        kodoc_relay_read_symbol(relay, symbol, coefficients);
+    }
+
+    bc::high_resolution_clock::time_point start, stop;
+
+    // Every recoded symbol combines all stored symbols
+    start = bc::high_resolution_clock::now();
+    for (i = 0; i < symbols; ++i)
+        kodoc_relay_write_symbol(relay, symbol, coefficients);
+    stop = bc::high_resolution_clock::now();
+
+    double recoding_time =
+        (double)(bc::duration_cast<bc::microseconds>(stop - start).count());
+
+    free(data_in);
+    free(symbol);
+    free(coefficients);
+
+    kodoc_delete_relay(relay);
+    kodoc_delete_coder(encoder);
+    kodoc_delete_factory(encoder_factory);
+
+    // The symbols that are read to recode a symbol
+    return ((double) symbols * symbols * symbol_size) / recoding_time;
+}
+
+// Measures the encoding rate of a batch encoder, which computes the coded
+// symbols of the binary field in groups that share a pass over the source
+// symbols.
+//
+// @param symbols The number of original symbols in the block
+// @param symbol_size The size of a symbol in bytes
+// @return The encoding rate in megabytes / seconds
+double run_batch_encoding_test(uint32_t symbols, uint32_t symbol_size)
+{
+    kodoc_batch_encoder_t encoder =
+        kodoc_new_batch_encoder(symbols, symbol_size);
+
+    uint32_t block_size = kodoc_batch_encoder_block_size(encoder);
+    uint8_t* data_in = (uint8_t*) malloc(block_size);
+
+    // The same number of coded symbols as in the coding test
+    uint32_t count = 2 * symbols;
+    uint8_t* symbol_data = (uint8_t*) malloc(count * symbol_size);
+    uint8_t* coefficients = (uint8_t*) malloc(
+        count * kodoc_batch_encoder_coefficient_vector_size(encoder));
+
+    uint32_t i;
+    for (i = 0; i < block_size; ++i)
+        data_in[i] = rand() % 256;
+
+    kodoc_batch_encoder_set_const_symbols(encoder, data_in, block_size);
+
+    bc::high_resolution_clock::time_point start, stop;
+
+    start = bc::high_resolution_clock::now();
+    uint32_t encoded_bytes = kodoc_batch_encoder_write_symbols(
+        encoder, symbol_data, coefficients, count);
+    stop = bc::high_resolution_clock::now();
+
+    double encoding_time =
+        (double)(bc::duration_cast<bc::microseconds>(stop - start).count());
+
+    free(data_in);
+    free(symbol_data);
+    free(coefficients);
+
+    kodoc_delete_batch_encoder(encoder);
+
+    return encoded_bytes / encoding_time;
+}
+
 // The main function should not be defined on Windows Phone
 #if !defined(PLATFORM_WINDOWS_PHONE)
 int main(int argc, const char* argv[])
@@ -211,6 +312,14 @@ int main(int argc, const char* argv[])
     printf("Runs: %d / Symbols: %d / Symbol_size: %d\n", runs, symbols,
            symbol_size);
 
+    // The throughput of a build with and without the trace layers can be
+    // compared by configuring with and without the "--disable_trace" option
+#if !defined(KODOC_DISABLE_TRACE)
+    printf("Trace layers: enabled\n");
+#else
+    printf("Trace layers: disabled\n");
+#endif
+
     for (uint32_t i = 0; i < runs; ++i)
     {
         results run = run_coding_test(field, symbols, symbol_size);
@@ -239,6 +348,26 @@ int main(int argc, const char* argv[])
         printf("Decoding failed.\n");
     }
 
+    double recoding_rate = 0.0;
+    for (uint32_t i = 0; i < runs; ++i)
+        recoding_rate += run_recoding_test(field, symbols, symbol_size);
+
+    printf("Average recoding rate: %0.2f MB/s\n", recoding_rate / runs);
+
+    // The batch encoder only supports the binary field
+    if (field == kodoc_binary)
+    {
+        double batch_encoding_rate = 0.0;
+        for (uint32_t i = 0; i < runs; ++i)
+        {
+            batch_encoding_rate +=
+                run_batch_encoding_test(symbols, symbol_size);
+        }
+
+        printf("Average batch encoding rate: %0.2f MB/s\n",
+               batch_encoding_rate / runs);
+    }
+
     return 0;
 }
 #endif
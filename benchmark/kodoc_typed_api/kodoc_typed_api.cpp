@@ -0,0 +1,243 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <platform/config.hpp>
+
+#include <kodoc/kodoc.h>
+#include <kodoc/kodoc.hpp>
+
+#include <vector>
+
+#include <boost/chrono.hpp>
+
+// Use boost::chrono to get a high-precision clock on all platforms
+// Note: std::chrono seems to have insufficient precision on Windows
+namespace bc = boost::chrono;
+
+/// @example kodoc_typed_api.cpp
+///
+/// Compares the C API with the header-only C++ API of kodoc.hpp for the
+/// full_vector codec. Every payload is written and read with a separate
+/// call, so the cost of the calls themselves is included. The difference
+/// between the two paths is largest for small symbols, where the coding
+/// operations are cheap.
+
+/// The total time spent in encoding and decoding for one of the APIs
+struct results
+{
+    bool success = true;
+    double encoding_time = 0.0;
+    double decoding_time = 0.0;
+    uint64_t payloads = 0;
+};
+
+static double elapsed_microseconds(bc::high_resolution_clock::time_point start,
+                                   bc::high_resolution_clock::time_point stop)
+{
+    return (double)bc::duration_cast<bc::nanoseconds>(stop - start).count() /
+        1000.0;
+}
+
+// Encodes and decodes the given number of generations with the C API
+static results run_c_api(int32_t field, uint32_t symbols,
+                         uint32_t symbol_size, uint32_t generations)
+{
+    results run;
+
+    kodoc_factory_t encoder_factory = kodoc_new_encoder_factory(
+        kodoc_full_vector, field, symbols, symbol_size);
+    kodoc_factory_t decoder_factory = kodoc_new_decoder_factory(
+        kodoc_full_vector, field, symbols, symbol_size);
+
+    uint32_t block_size = symbols * symbol_size;
+    std::vector<uint8_t> data_in(block_size);
+    std::vector<uint8_t> data_out(block_size);
+
+    for (auto& e : data_in)
+        e = rand() % 256;
+
+    std::vector<uint8_t> payload(
+        kodoc_factory_max_payload_size(encoder_factory));
+
+    bc::high_resolution_clock::time_point start, stop;
+
+    for (uint32_t g = 0; g < generations; ++g)
+    {
+        kodoc_coder_t encoder = kodoc_factory_build_coder(encoder_factory);
+        kodoc_coder_t decoder = kodoc_factory_build_coder(decoder_factory);
+
+        // We measure pure coding, so we always turn off the systematic mode
+        kodoc_set_systematic_off(encoder);
+
+        kodoc_set_const_symbols(encoder, data_in.data(), block_size);
+        kodoc_set_mutable_symbols(decoder, data_out.data(), block_size);
+
+        while (!kodoc_is_complete(decoder))
+        {
+            start = bc::high_resolution_clock::now();
+            kodoc_write_payload(encoder, payload.data());
+            stop = bc::high_resolution_clock::now();
+            run.encoding_time += elapsed_microseconds(start, stop);
+
+            start = bc::high_resolution_clock::now();
+            kodoc_read_payload(decoder, payload.data());
+            stop = bc::high_resolution_clock::now();
+            run.decoding_time += elapsed_microseconds(start, stop);
+
+            ++run.payloads;
+        }
+
+        run.success &= memcmp(data_in.data(), data_out.data(),
+                              block_size) == 0;
+
+        kodoc_delete_coder(encoder);
+        kodoc_delete_coder(decoder);
+    }
+
+    kodoc_delete_factory(encoder_factory);
+    kodoc_delete_factory(decoder_factory);
+
+    return run;
+}
+
+// Encodes and decodes the given number of generations with kodoc.hpp
+template<class Field>
+static results run_typed_api(uint32_t symbols, uint32_t symbol_size,
+                             uint32_t generations)
+{
+    results run;
+
+    uint32_t block_size = symbols * symbol_size;
+    std::vector<uint8_t> data_in(block_size);
+    std::vector<uint8_t> data_out(block_size);
+
+    for (auto& e : data_in)
+        e = rand() % 256;
+
+    bc::high_resolution_clock::time_point start, stop;
+
+    for (uint32_t g = 0; g < generations; ++g)
+    {
+        kodoc::encoder<kodoc::codec::full_vector, Field> encoder(
+            symbols, symbol_size);
+        kodoc::decoder<kodoc::codec::full_vector, Field> decoder(
+            symbols, symbol_size);
+
+        encoder.set_systematic_off();
+
+        encoder.set_const_symbols(data_in.data(), block_size);
+        decoder.set_mutable_symbols(data_out.data(), block_size);
+
+        std::vector<uint8_t> payload(encoder.payload_size());
+
+        while (!decoder.is_complete())
+        {
+            start = bc::high_resolution_clock::now();
+            encoder.write_payload(payload.data());
+            stop = bc::high_resolution_clock::now();
+            run.encoding_time += elapsed_microseconds(start, stop);
+
+            start = bc::high_resolution_clock::now();
+            decoder.read_payload(payload.data());
+            stop = bc::high_resolution_clock::now();
+            run.decoding_time += elapsed_microseconds(start, stop);
+
+            ++run.payloads;
+        }
+
+        run.success &= memcmp(data_in.data(), data_out.data(),
+                              block_size) == 0;
+    }
+
+    return run;
+}
+
+static void print_results(const char* api, const results& run,
+                          uint32_t symbol_size)
+{
+    double bytes = (double)run.payloads * symbol_size;
+
+    printf("%-6s encoding: %8.3f us/payload %9.2f MB/s / "
+           "decoding: %8.3f us/payload %9.2f MB/s\n", api,
+           run.encoding_time / run.payloads, bytes / run.encoding_time,
+           run.decoding_time / run.payloads, bytes / run.decoding_time);
+}
+
+// The main function should not be defined on Windows Phone
+#if !defined(PLATFORM_WINDOWS_PHONE)
+int main(int argc, const char* argv[])
+{
+    if (argc != 4 && argc != 5)
+    {
+        printf("Usage: %s [binary|binary4|binary8] "
+               "symbols symbol_size {generations=100}\n", argv[0]);
+        return 1;
+    }
+
+    uint32_t symbols = atoi(argv[2]);
+    uint32_t symbol_size = atoi(argv[3]);
+
+    uint32_t generations = 100;
+    if (argc == 5)
+    {
+        generations = atoi(argv[4]);
+    }
+
+    // Set the random seed to randomize encoded data
+    srand((uint32_t)time(NULL));
+
+    // The field of the C API is selected at runtime, while every field of
+    // the typed API is a separate instantiation
+    results c_run;
+    results typed_run;
+
+    if (strcmp(argv[1], "binary") == 0)
+    {
+        c_run = run_c_api(kodoc_binary, symbols, symbol_size, generations);
+        typed_run = run_typed_api<kodoc::field::binary>(
+            symbols, symbol_size, generations);
+    }
+    else if (strcmp(argv[1], "binary4") == 0)
+    {
+        c_run = run_c_api(kodoc_binary4, symbols, symbol_size, generations);
+        typed_run = run_typed_api<kodoc::field::binary4>(
+            symbols, symbol_size, generations);
+    }
+    else if (strcmp(argv[1], "binary8") == 0)
+    {
+        c_run = run_c_api(kodoc_binary8, symbols, symbol_size, generations);
+        typed_run = run_typed_api<kodoc::field::binary8>(
+            symbols, symbol_size, generations);
+    }
+    else
+    {
+        printf("Invalid finite field: %s\n", argv[1]);
+        return 1;
+    }
+
+    printf("Generations: %u / Symbols: %u / Symbol_size: %u\n",
+           generations, symbols, symbol_size);
+
+    print_results("C", c_run, symbol_size);
+    print_results("C++", typed_run, symbol_size);
+
+    if (c_run.success && typed_run.success)
+    {
+        printf("All data decoded correctly.\n");
+    }
+    else
+    {
+        printf("Decoding failed.\n");
+    }
+
+    return 0;
+}
+#endif
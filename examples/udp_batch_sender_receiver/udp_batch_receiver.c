@@ -0,0 +1,247 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+// recvmmsg() is a GNU extension
+#define _GNU_SOURCE
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <kodoc/kodoc.h>
+
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/// @example udp_batch_receiver.c
+///
+/// High-rate UDP receiver for the objects sent by udp_batch_sender.
+/// Datagrams are received in batches with a single recvmmsg() call and
+/// passed to an object decoder, which decodes all generations in flight.
+/// When the object is complete (or no data arrived for the timeout), the
+/// goodput and the coding overhead are reported.
+
+// The number of datagrams received by a single recvmmsg() call
+#define BATCH_SIZE 64
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// Checks the pattern written by the sender
+static int verify_object(const uint8_t* data, uint64_t size)
+{
+    uint64_t i;
+    for (i = 0; i < size; ++i)
+    {
+        if (data[i] != (uint8_t)((i * 2654435761ULL) >> 13))
+            return 0;
+    }
+    return 1;
+}
+
+int main(int argc, char* argv[])
+{
+    int socket_descriptor;
+    struct sockaddr_in local_address;
+    int buffer_size = 16 * 1024 * 1024;
+
+    int32_t codec = kodoc_full_vector;
+    int32_t finite_field = kodoc_binary8;
+
+    if (argc != 5 && argc != 6)
+    {
+        printf("usage : %s <port> <object_size> <symbols> <symbol_size> "
+               "{timeout_ms=2000}\n", argv[0]);
+        exit(1);
+    }
+
+    uint64_t object_size = strtoull(argv[2], NULL, 10);
+    uint32_t symbols = atoi(argv[3]);
+    uint32_t symbol_size = atoi(argv[4]);
+    uint32_t timeout_ms = argc == 6 ? (uint32_t)atoi(argv[5]) : 2000;
+
+    if (object_size == 0 || symbols == 0 || symbol_size == 0)
+    {
+        printf("%s: invalid arguments\n", argv[0]);
+        exit(1);
+    }
+
+    socket_descriptor = socket(AF_INET, SOCK_DGRAM, 0);
+    if (socket_descriptor < 0)
+    {
+        printf("%s: cannot open socket \n", argv[0]);
+        exit(1);
+    }
+
+    // A large receive buffer prevents drops while a batch is decoded
+    setsockopt(socket_descriptor, SOL_SOCKET, SO_RCVBUF, &buffer_size,
+               sizeof(buffer_size));
+
+    // The receive timeout bounds the wait when the sender is done
+    struct timeval timeout;
+    timeout.tv_sec = timeout_ms / 1000;
+    timeout.tv_usec = (timeout_ms % 1000) * 1000;
+    setsockopt(socket_descriptor, SOL_SOCKET, SO_RCVTIMEO, &timeout,
+               sizeof(timeout));
+
+    memset(&local_address, 0, sizeof(local_address));
+    local_address.sin_family = AF_INET;
+    local_address.sin_addr.s_addr = htonl(INADDR_ANY);
+    local_address.sin_port = htons(atoi(argv[1]));
+
+    if (bind(socket_descriptor, (struct sockaddr*)&local_address,
+             sizeof(local_address)) < 0)
+    {
+        printf("%s: cannot bind port %s\n", argv[0], argv[1]);
+        exit(1);
+    }
+
+    uint8_t* data_out = (uint8_t*)calloc(object_size, 1);
+
+    kodoc_factory_t decoder_factory = kodoc_new_decoder_factory(
+        codec, finite_field, symbols, symbol_size);
+
+    kodoc_object_decoder_t decoder = kodoc_new_object_decoder(
+        decoder_factory, data_out, object_size);
+
+    uint32_t blocks = kodoc_object_decoder_blocks(decoder);
+    uint32_t payload_size = kodoc_object_decoder_payload_size(decoder);
+
+    // Every datagram of a batch is received into its own buffer
+    uint8_t* buffers = (uint8_t*)malloc(BATCH_SIZE * payload_size);
+    struct iovec iov[BATCH_SIZE];
+    struct mmsghdr messages[BATCH_SIZE];
+
+    uint32_t i;
+    for (i = 0; i < BATCH_SIZE; ++i)
+    {
+        iov[i].iov_base = buffers + i * payload_size;
+        iov[i].iov_len = payload_size;
+    }
+
+    uint64_t packets = 0;
+    uint64_t bytes = 0;
+    uint64_t start = 0;
+    uint64_t stop = 0;
+
+    printf("Waiting for %llu bytes in %u generations on port %s\n",
+           (unsigned long long)object_size, blocks, argv[1]);
+
+    while (!kodoc_object_decoder_is_complete(decoder))
+    {
+        memset(messages, 0, sizeof(messages));
+        for (i = 0; i < BATCH_SIZE; ++i)
+        {
+            messages[i].msg_hdr.msg_iov = &iov[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        // Wait for the first datagram, and take all others that are queued
+        int received = recvmmsg(socket_descriptor, messages, BATCH_SIZE,
+                                MSG_WAITFORONE, NULL);
+
+        if (received < 0)
+        {
+            if (errno == EINTR)
+                continue;
+
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                printf("Timeout: no data received for %u ms\n", timeout_ms);
+                break;
+            }
+
+            printf("%s: cannot receive data: %s\n", argv[0],
+                   strerror(errno));
+            exit(1);
+        }
+
+        if (start == 0)
+            start = now_ns();
+
+        for (i = 0; i < (uint32_t)received; ++i)
+        {
+            // The datagrams after the last useful one are not counted
+            if (kodoc_object_decoder_is_complete(decoder))
+                break;
+
+            ++packets;
+            bytes += messages[i].msg_len;
+
+            kodoc_object_decoder_read_payload(
+                decoder, (uint8_t*)iov[i].iov_base);
+        }
+
+        stop = now_ns();
+    }
+
+    uint32_t completed = 0;
+    uint64_t total_symbols = 0;
+    for (i = 0; i < blocks; ++i)
+    {
+        completed += kodoc_object_decoder_is_block_complete(decoder, i) != 0;
+        total_symbols += kodoc_object_decoder_block_symbols(decoder, i);
+    }
+
+    double seconds = stop > start ? (stop - start) / 1e9 : 0.0;
+    int success = 0;
+
+    printf("Received %llu packets, %llu bytes in %.3f s\n",
+           (unsigned long long)packets, (unsigned long long)bytes, seconds);
+    printf("Completed generations: %u / %u\n", completed, blocks);
+
+    if (seconds > 0.0)
+    {
+        printf("Receive rate: %.1f Mbit/s\n", bytes * 8 / seconds / 1e6);
+    }
+
+    if (kodoc_object_decoder_is_complete(decoder))
+    {
+        // Goodput only counts the object data, while the overhead is the
+        // share of packets that did not carry new information
+        if (seconds > 0.0)
+        {
+            printf("Goodput: %.1f Mbit/s\n",
+                   object_size * 8 / seconds / 1e6);
+        }
+        printf("Overhead: %.2f %% (%llu packets for %llu symbols)\n",
+               100.0 * (double)(packets - total_symbols) / total_symbols,
+               (unsigned long long)packets,
+               (unsigned long long)total_symbols);
+
+        success = verify_object(data_out, object_size);
+
+        if (success)
+        {
+            printf("Data decoded correctly\n");
+        }
+        else
+        {
+            printf("Unexpected failure to decode, please file a bug report "
+                   ":)\n");
+        }
+    }
+
+    close(socket_descriptor);
+
+    free(buffers);
+    free(data_out);
+
+    kodoc_delete_object_decoder(decoder);
+    kodoc_delete_factory(decoder_factory);
+
+    return success ? 0 : 1;
+}
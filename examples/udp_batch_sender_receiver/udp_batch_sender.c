@@ -0,0 +1,273 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+// sendmmsg() is a GNU extension
+#define _GNU_SOURCE
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <kodoc/kodoc.h>
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <unistd.h>
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/// @example udp_batch_sender.c
+///
+/// High-rate UDP sender for an object that spans several generations.
+/// Payloads are produced in batches and sent with a single sendmmsg() call
+/// per batch. The source symbols of the systematic phase are not copied:
+/// every datagram is gathered from a small header and a pointer into the
+/// object. The send rate is paced against a monotonic clock instead of
+/// sleeping a fixed time between packets. Run udp_batch_receiver with the
+/// same object size, symbols and symbol size on the other side, e.g. over
+/// the loopback interface:
+///
+///     ./udp_batch_receiver 45123 10000000 64 1400 &
+///     ./udp_batch_sender 127.0.0.1 45123 10000000 64 1400 800 10 4
+
+// The number of datagrams passed to a single sendmmsg() call
+#define BATCH_SIZE 64
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// Waits until the given point in time on the monotonic clock
+static void wait_until_ns(uint64_t deadline)
+{
+    struct timespec ts;
+    ts.tv_sec = (time_t)(deadline / 1000000000ULL);
+    ts.tv_nsec = (long)(deadline % 1000000000ULL);
+
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) ==
+           EINTR)
+    { }
+}
+
+// Fills the object with a pattern that the receiver can verify
+static void fill_object(uint8_t* data, uint64_t size)
+{
+    uint64_t i;
+    for (i = 0; i < size; ++i)
+        data[i] = (uint8_t)((i * 2654435761ULL) >> 13);
+}
+
+int main(int argc, char* argv[])
+{
+    int socket_descriptor;
+    struct sockaddr_in remote_address;
+    struct hostent* host;
+    int buffer_size = 4 * 1024 * 1024;
+
+    int32_t codec = kodoc_full_vector;
+    int32_t finite_field = kodoc_binary8;
+
+    if (argc != 9)
+    {
+        printf("usage : %s <server> <port> <object_size> <symbols> "
+               "<symbol_size> <rate_mbps> <redundancy_percent> "
+               "<generations_in_flight>\n", argv[0]);
+        exit(1);
+    }
+
+    uint64_t object_size = strtoull(argv[3], NULL, 10);
+    uint32_t symbols = atoi(argv[4]);
+    uint32_t symbol_size = atoi(argv[5]);
+    double rate_mbps = atof(argv[6]);
+    uint32_t redundancy = atoi(argv[7]);
+    uint32_t in_flight = atoi(argv[8]);
+
+    if (object_size == 0 || symbols == 0 || symbol_size == 0 ||
+        rate_mbps <= 0.0 || in_flight == 0)
+    {
+        printf("%s: invalid arguments\n", argv[0]);
+        exit(1);
+    }
+
+    // Get server IP address (no check if input is IP address or DNS name)
+    host = gethostbyname(argv[1]);
+    if (host == NULL)
+    {
+        printf("%s: unknown host '%s' \n", argv[0], argv[1]);
+        exit(1);
+    }
+
+    memset(&remote_address, 0, sizeof(remote_address));
+    remote_address.sin_family = host->h_addrtype;
+    memcpy(&remote_address.sin_addr.s_addr, host->h_addr_list[0],
+           host->h_length);
+    remote_address.sin_port = htons(atoi(argv[2]));
+
+    socket_descriptor = socket(AF_INET, SOCK_DGRAM, 0);
+    if (socket_descriptor < 0)
+    {
+        printf("%s: cannot open socket \n", argv[0]);
+        exit(1);
+    }
+
+    // A large send buffer absorbs the bursts of a batch
+    setsockopt(socket_descriptor, SOL_SOCKET, SO_SNDBUF, &buffer_size,
+               sizeof(buffer_size));
+
+    // Connect the socket, so the datagrams do not need an address
+    if (connect(socket_descriptor, (struct sockaddr*)&remote_address,
+                sizeof(remote_address)) < 0)
+    {
+        printf("%s: cannot connect socket \n", argv[0]);
+        exit(1);
+    }
+
+    uint8_t* data_in = (uint8_t*)malloc(object_size);
+    fill_object(data_in, object_size);
+
+    kodoc_factory_t encoder_factory = kodoc_new_encoder_factory(
+        codec, finite_field, symbols, symbol_size);
+
+    kodoc_object_encoder_t encoder = kodoc_new_object_encoder(
+        encoder_factory, data_in, object_size);
+
+    uint32_t blocks = kodoc_object_encoder_blocks(encoder);
+    uint32_t payload_size = kodoc_object_encoder_payload_size(encoder);
+
+    // Every block is sent with a fixed number of payloads, as there is no
+    // feedback from the receiver
+    uint32_t* remaining = (uint32_t*)malloc(blocks * sizeof(uint32_t));
+    uint32_t block;
+    for (block = 0; block < blocks; ++block)
+    {
+        uint32_t block_symbols =
+            kodoc_object_encoder_block_symbols(encoder, block);
+        remaining[block] = block_symbols + (block_symbols * redundancy) / 100;
+    }
+
+    // The headers and coded payloads of a batch, and the gather lists
+    uint8_t* buffers = (uint8_t*)malloc(BATCH_SIZE * payload_size);
+    kodoc_iovec_t entries[BATCH_SIZE][2];
+    struct iovec iov[BATCH_SIZE][2];
+    struct mmsghdr messages[BATCH_SIZE];
+
+    // The generations in flight are interleaved, so a burst of losses is
+    // spread over several generations
+    uint32_t first_block = 0;
+    uint32_t next_block = 0;
+    if (in_flight > blocks)
+        in_flight = blocks;
+
+    uint64_t packets = 0;
+    uint64_t bytes = 0;
+    double ns_per_byte = 8000.0 / rate_mbps;
+
+    printf("Sending %llu bytes in %u generations to %s:%d at %.1f Mbit/s\n",
+           (unsigned long long)object_size, blocks,
+           inet_ntoa(remote_address.sin_addr), atoi(argv[2]), rate_mbps);
+
+    uint64_t start = now_ns();
+
+    while (first_block < blocks)
+    {
+        uint32_t count = 0;
+        uint32_t batch_bytes = 0;
+
+        // Produce a batch of payloads from the generations in flight
+        while (count < BATCH_SIZE && first_block < blocks)
+        {
+            uint32_t window = blocks - first_block;
+            if (window > in_flight)
+                window = in_flight;
+
+            block = first_block + (next_block++ % window);
+
+            if (remaining[block] == 0)
+            {
+                // The generations are sent in order, so the window only
+                // moves when its first generation is done
+                if (block == first_block)
+                {
+                    ++first_block;
+                    next_block = 0;
+                }
+                continue;
+            }
+            --remaining[block];
+
+            uint8_t* buffer = buffers + count * payload_size;
+            uint32_t used = kodoc_object_encoder_write_payload_iov(
+                encoder, block, buffer, entries[count]);
+
+            uint32_t i;
+            uint32_t size = 0;
+            for (i = 0; i < used; ++i)
+            {
+                iov[count][i].iov_base = (void*)entries[count][i].data;
+                iov[count][i].iov_len = entries[count][i].size;
+                size += entries[count][i].size;
+            }
+
+            memset(&messages[count], 0, sizeof(messages[count]));
+            messages[count].msg_hdr.msg_iov = iov[count];
+            messages[count].msg_hdr.msg_iovlen = used;
+
+            batch_bytes += size;
+            ++count;
+        }
+
+        if (count == 0)
+            break;
+
+        // Pace the batch: it may only leave once the previous bytes have
+        // been sent at the configured rate
+        wait_until_ns(start + (uint64_t)(bytes * ns_per_byte));
+
+        uint32_t sent = 0;
+        while (sent < count)
+        {
+            int result = sendmmsg(socket_descriptor, messages + sent,
+                                  count - sent, 0);
+
+            if (result < 0)
+            {
+                if (errno == EINTR || errno == ENOBUFS || errno == EAGAIN)
+                    continue;
+
+                printf("%s: cannot send data: %s\n", argv[0],
+                       strerror(errno));
+                exit(1);
+            }
+            sent += result;
+        }
+
+        packets += count;
+        bytes += batch_bytes;
+    }
+
+    double seconds = (now_ns() - start) / 1e9;
+
+    printf("Sent %llu packets, %llu bytes in %.3f s\n",
+           (unsigned long long)packets, (unsigned long long)bytes, seconds);
+    printf("Send rate: %.1f Mbit/s\n", bytes * 8 / seconds / 1e6);
+
+    close(socket_descriptor);
+
+    free(buffers);
+    free(remaining);
+    free(data_in);
+
+    kodoc_delete_object_encoder(encoder);
+    kodoc_delete_factory(encoder_factory);
+
+    return 0;
+}
@@ -0,0 +1,76 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include "allocator.hpp"
+
+#include <cassert>
+#include <cstdint>
+
+#include <kodo_core/api/api.hpp>
+
+#include "allocator_binding.hpp"
+
+namespace kodoc
+{
+kodoc_allocator_t factory_allocator(kodoc_factory_t factory)
+{
+    auto api = (kodo_core::api::final_interface*) factory;
+    assert(api);
+
+    auto allocator_api = dynamic_cast<allocator_interface*>(api);
+    assert(allocator_api);
+
+    return allocator_api->allocator();
+}
+
+namespace
+{
+kodoc_factory_t set_allocator(kodoc_factory_t factory,
+                              const kodoc_allocator_t* allocator)
+{
+    if (factory == nullptr)
+        return factory;
+
+    auto api = (kodo_core::api::final_interface*) factory;
+    auto allocator_api = dynamic_cast<allocator_interface*>(api);
+    assert(allocator_api);
+
+    allocator_api->set_allocator(*allocator);
+    return factory;
+}
+}
+}
+
+//------------------------------------------------------------------
+// ALLOCATOR API
+//------------------------------------------------------------------
+
+kodoc_factory_t kodoc_new_encoder_factory_with_allocator(
+    int32_t codec, int32_t finite_field, uint32_t max_symbols,
+    uint32_t max_symbol_size, const kodoc_allocator_t* allocator)
+{
+    assert(allocator);
+    assert(allocator->alloc);
+    assert(allocator->free);
+
+    return kodoc::set_allocator(
+        kodoc_new_encoder_factory(
+            codec, finite_field, max_symbols, max_symbol_size),
+        allocator);
+}
+
+kodoc_factory_t kodoc_new_decoder_factory_with_allocator(
+    int32_t codec, int32_t finite_field, uint32_t max_symbols,
+    uint32_t max_symbol_size, const kodoc_allocator_t* allocator)
+{
+    assert(allocator);
+    assert(allocator->alloc);
+    assert(allocator->free);
+
+    return kodoc::set_allocator(
+        kodoc_new_decoder_factory(
+            codec, finite_field, max_symbols, max_symbol_size),
+        allocator);
+}
@@ -0,0 +1,111 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "kodoc.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+namespace kodoc
+{
+namespace detail
+{
+inline void* default_alloc(uint64_t size, void* context)
+{
+    (void) context;
+    return malloc((size_t) size);
+}
+
+inline void default_free(void* pointer, uint64_t size, void* context)
+{
+    (void) size;
+    (void) context;
+    free(pointer);
+}
+}
+
+/// @return The allocator that uses the global heap
+inline kodoc_allocator_t default_allocator()
+{
+    kodoc_allocator_t allocator;
+    allocator.alloc = detail::default_alloc;
+    allocator.free = detail::default_free;
+    allocator.context = nullptr;
+    return allocator;
+}
+
+/// @return The allocator of a factory, which is the default allocator
+///         unless the factory was built with an allocator
+kodoc_allocator_t factory_allocator(kodoc_factory_t factory);
+
+/// Standard allocator that obtains its memory from a kodoc_allocator_t,
+/// so that the containers of kodo-c can use the allocator of a factory
+template<class T>
+class hook_allocator
+{
+public:
+
+    using value_type = T;
+
+    hook_allocator() :
+        m_allocator(default_allocator())
+    { }
+
+    explicit hook_allocator(const kodoc_allocator_t& allocator) :
+        m_allocator(allocator)
+    { }
+
+    template<class U>
+    hook_allocator(const hook_allocator<U>& other) :
+        m_allocator(other.allocator())
+    { }
+
+    T* allocate(std::size_t n)
+    {
+        void* pointer = m_allocator.alloc(n * sizeof(T), m_allocator.context);
+        if (pointer == nullptr)
+            throw std::bad_alloc();
+
+        return static_cast<T*>(pointer);
+    }
+
+    void deallocate(T* pointer, std::size_t n)
+    {
+        m_allocator.free(pointer, n * sizeof(T), m_allocator.context);
+    }
+
+    const kodoc_allocator_t& allocator() const
+    {
+        return m_allocator;
+    }
+
+private:
+
+    kodoc_allocator_t m_allocator;
+};
+
+template<class T, class U>
+bool operator==(const hook_allocator<T>& a, const hook_allocator<U>& b)
+{
+    return a.allocator().alloc == b.allocator().alloc &&
+           a.allocator().free == b.allocator().free &&
+           a.allocator().context == b.allocator().context;
+}
+
+template<class T, class U>
+bool operator!=(const hook_allocator<T>& a, const hook_allocator<U>& b)
+{
+    return !(a == b);
+}
+
+/// A vector that obtains its memory from a kodoc_allocator_t
+template<class T>
+using hook_vector = std::vector<T, hook_allocator<T>>;
+}
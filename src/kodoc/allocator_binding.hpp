@@ -0,0 +1,46 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "kodoc.h"
+
+#include "allocator.hpp"
+
+namespace kodoc
+{
+/// Interface for factories that carry an allocator for the buffers that
+/// kodo-c allocates on behalf of the factory
+struct allocator_interface
+{
+    virtual ~allocator_interface()
+    { }
+
+    virtual const kodoc_allocator_t& allocator() const = 0;
+
+    virtual void set_allocator(const kodoc_allocator_t& allocator) = 0;
+};
+
+/// Stores the allocator of a factory
+template<class Stack>
+class allocator_binding : public Stack, public virtual allocator_interface
+{
+public:
+
+    const kodoc_allocator_t& allocator() const override
+    {
+        return m_allocator;
+    }
+
+    void set_allocator(const kodoc_allocator_t& allocator) override
+    {
+        m_allocator = allocator;
+    }
+
+private:
+
+    kodoc_allocator_t m_allocator = default_allocator();
+};
+}
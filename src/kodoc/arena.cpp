@@ -0,0 +1,125 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include "arena.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace kodoc
+{
+namespace
+{
+// The alignment of all allocations, which is sufficient for any type
+const uint64_t alignment = 16;
+
+void* arena_alloc(uint64_t size, void* context)
+{
+    auto a = static_cast<arena*>(context);
+    return a->allocate(size);
+}
+
+void arena_free(void* pointer, uint64_t size, void* context)
+{
+    // The memory is released when the arena is destroyed
+    (void) pointer;
+    (void) size;
+    (void) context;
+}
+}
+
+arena::arena(uint64_t chunk_size) :
+    m_chunk_size(chunk_size),
+    m_position(nullptr),
+    m_available(0),
+    m_reserved(0),
+    m_used(0)
+{
+    assert(m_chunk_size > 0);
+}
+
+arena::~arena()
+{
+    for (auto chunk : m_chunks)
+        free(chunk);
+}
+
+void* arena::allocate(uint64_t size)
+{
+    size = (size + alignment - 1) & ~(alignment - 1);
+
+    if (size > m_available)
+    {
+        // Large allocations get a chunk of their own
+        uint64_t chunk_size = std::max(size, m_chunk_size);
+        uint8_t* chunk = (uint8_t*) malloc((size_t) chunk_size);
+        if (chunk == nullptr)
+            return nullptr;
+
+        m_chunks.push_back(chunk);
+        m_reserved += chunk_size;
+
+        m_position = chunk;
+        m_available = chunk_size;
+    }
+
+    void* pointer = m_position;
+    m_position += size;
+    m_available -= size;
+    m_used += size;
+
+    return pointer;
+}
+
+kodoc_allocator_t arena::allocator()
+{
+    kodoc_allocator_t allocator;
+    allocator.alloc = arena_alloc;
+    allocator.free = arena_free;
+    allocator.context = this;
+    return allocator;
+}
+}
+
+//------------------------------------------------------------------
+// ARENA API
+//------------------------------------------------------------------
+
+kodoc_arena_t kodoc_new_arena(uint64_t chunk_size)
+{
+    assert(chunk_size > 0);
+    return (kodoc_arena_t) new kodoc::arena(chunk_size);
+}
+
+void kodoc_delete_arena(kodoc_arena_t arena)
+{
+    auto a = (kodoc::arena*) arena;
+    assert(a);
+    delete a;
+}
+
+kodoc_allocator_t kodoc_arena_allocator(kodoc_arena_t arena)
+{
+    auto a = (kodoc::arena*) arena;
+    assert(a);
+    return a->allocator();
+}
+
+uint64_t kodoc_arena_reserved(kodoc_arena_t arena)
+{
+    auto a = (kodoc::arena*) arena;
+    assert(a);
+    return a->reserved();
+}
+
+uint64_t kodoc_arena_used(kodoc_arena_t arena)
+{
+    auto a = (kodoc::arena*) arena;
+    assert(a);
+    return a->used();
+}
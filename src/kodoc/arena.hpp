@@ -0,0 +1,61 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "kodoc.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace kodoc
+{
+/// Bump allocator that takes its memory from the heap in large chunks.
+/// Freeing a single allocation has no effect, all memory is returned to
+/// the heap at once when the arena is destroyed. The arena is not
+/// synchronized, so it must only be used by one thread at a time.
+class arena
+{
+public:
+
+    /// @param chunk_size The size of the chunks taken from the heap
+    explicit arena(uint64_t chunk_size);
+
+    /// Frees all chunks
+    ~arena();
+
+    arena(const arena&) = delete;
+    arena& operator=(const arena&) = delete;
+
+    /// @return A buffer of the given size, aligned for any type
+    void* allocate(uint64_t size);
+
+    /// @return The total size of the chunks taken from the heap
+    uint64_t reserved() const
+    {
+        return m_reserved;
+    }
+
+    /// @return The total size of the allocations made from the arena
+    uint64_t used() const
+    {
+        return m_used;
+    }
+
+    /// @return An allocator that allocates from the arena
+    kodoc_allocator_t allocator();
+
+private:
+
+    uint64_t m_chunk_size;
+    std::vector<uint8_t*> m_chunks;
+
+    uint8_t* m_position;
+    uint64_t m_available;
+
+    uint64_t m_reserved;
+    uint64_t m_used;
+};
+}
@@ -0,0 +1,225 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include "batch_encoder.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
+#include "simd.hpp"
+
+namespace kodoc
+{
+const uint32_t batch_encoder::max_group;
+const uint32_t batch_encoder::tile_buffer_size;
+const uint32_t batch_encoder::nontemporal_threshold;
+
+batch_encoder::batch_encoder(uint32_t symbols, uint32_t symbol_size) :
+    m_symbols(symbols),
+    m_symbol_size(symbol_size),
+    m_data(nullptr),
+    m_selection(symbols),
+    m_tiles(tile_buffer_size + 64),
+    m_random(std::random_device()())
+{
+    assert(m_symbols > 0);
+    assert(m_symbol_size > 0);
+}
+
+void batch_encoder::set_const_symbols(const uint8_t* data, uint32_t size)
+{
+    assert(data);
+    assert(size == block_size());
+    (void) size;
+
+    m_data = data;
+}
+
+uint32_t batch_encoder::write_symbols(uint8_t* symbol_data,
+                                      uint8_t* coefficients, uint32_t count)
+{
+    assert(m_data && "The const symbols must be set first");
+    assert(symbol_data);
+    assert(coefficients);
+
+    uint32_t vector_size = coefficient_vector_size();
+    for (uint32_t k = 0; k < count; ++k)
+        random_coefficients(coefficients + k * vector_size);
+
+    bool nontemporal =
+        (uint64_t) count * m_symbol_size >= nontemporal_threshold;
+
+    for (uint32_t first = 0; first < count; first += max_group)
+    {
+        uint32_t group = std::min(count - first, max_group);
+
+        // Bit k of a selection is the coefficient of the source symbol in
+        // coded symbol first + k
+        for (uint32_t j = 0; j < m_symbols; ++j)
+        {
+            uint32_t selection = 0;
+            for (uint32_t k = 0; k < group; ++k)
+            {
+                const uint8_t* vector =
+                    coefficients + (first + k) * vector_size;
+                selection |= (uint32_t)((vector[j / 8] >> (j % 8)) & 1) << k;
+            }
+            m_selection[j] = selection;
+        }
+
+        encode_group(symbol_data + first * m_symbol_size, group,
+                     nontemporal);
+    }
+
+    return count * m_symbol_size;
+}
+
+void batch_encoder::encode_group(uint8_t* symbol_data, uint32_t group,
+                                 bool nontemporal)
+{
+    const simd_kernels& kernels = simd();
+
+    uint8_t* tiles = m_tiles.data() + (-(uintptr_t) m_tiles.data() % 64);
+
+    // The tiles are a multiple of a cache line, so the tiles of the coded
+    // symbols stay aligned in the buffer
+    uint32_t tile_size = std::min(tile_buffer_size / group / 64 * 64,
+                                  m_symbol_size);
+
+    for (uint32_t offset = 0; offset < m_symbol_size; offset += tile_size)
+    {
+        uint32_t size = std::min(tile_size, m_symbol_size - offset);
+
+        // The first source symbol of a coded symbol is copied, so the
+        // tiles are not cleared. Every coded symbol has a coefficient.
+        uint32_t started = 0;
+
+        const uint8_t* source = m_data + offset;
+        for (uint32_t j = 0; j < m_symbols; ++j, source += m_symbol_size)
+        {
+            uint32_t selection = m_selection[j];
+            while (selection != 0)
+            {
+                uint32_t k = 0;
+                while (((selection >> k) & 1) == 0)
+                    ++k;
+                selection &= selection - 1;
+
+                uint8_t* tile = tiles + k * tile_size;
+                if ((started >> k) & 1)
+                {
+                    kernels.region_add(tile, source, size);
+                }
+                else
+                {
+                    memcpy(tile, source, size);
+                    started |= 1U << k;
+                }
+            }
+        }
+
+        for (uint32_t k = 0; k < group; ++k)
+        {
+            uint8_t* dest = symbol_data + k * m_symbol_size + offset;
+            if (nontemporal)
+                kernels.region_copy_nontemporal(dest, tiles + k * tile_size,
+                                                size);
+            else
+                memcpy(dest, tiles + k * tile_size, size);
+        }
+    }
+}
+
+void batch_encoder::random_coefficients(uint8_t* coefficients)
+{
+    uint32_t vector_size = coefficient_vector_size();
+    for (uint32_t i = 0; i < vector_size; ++i)
+        coefficients[i] = (uint8_t) m_random();
+
+    // The bits after the last symbol are kept zero
+    if (m_symbols % 8 != 0)
+    {
+        coefficients[vector_size - 1] &=
+            (uint8_t)((1U << (m_symbols % 8)) - 1);
+    }
+
+    // A coded symbol without coefficients carries no information
+    bool zero = std::all_of(coefficients, coefficients + vector_size,
+                            [](uint8_t c) { return c == 0; });
+    if (zero)
+    {
+        uint32_t index = m_random() % m_symbols;
+        coefficients[index / 8] = (uint8_t)(1U << (index % 8));
+    }
+}
+}
+
+//------------------------------------------------------------------
+// BATCH ENCODER API
+//------------------------------------------------------------------
+
+kodoc_batch_encoder_t kodoc_new_batch_encoder(uint32_t symbols,
+                                              uint32_t symbol_size)
+{
+    assert(symbols > 0);
+    assert(symbol_size > 0);
+    return (kodoc_batch_encoder_t) new kodoc::batch_encoder(
+        symbols, symbol_size);
+}
+
+void kodoc_delete_batch_encoder(kodoc_batch_encoder_t encoder)
+{
+    auto e = (kodoc::batch_encoder*) encoder;
+    assert(e);
+    delete e;
+}
+
+uint32_t kodoc_batch_encoder_symbols(kodoc_batch_encoder_t encoder)
+{
+    auto e = (kodoc::batch_encoder*) encoder;
+    assert(e);
+    return e->symbols();
+}
+
+uint32_t kodoc_batch_encoder_symbol_size(kodoc_batch_encoder_t encoder)
+{
+    auto e = (kodoc::batch_encoder*) encoder;
+    assert(e);
+    return e->symbol_size();
+}
+
+uint32_t kodoc_batch_encoder_block_size(kodoc_batch_encoder_t encoder)
+{
+    auto e = (kodoc::batch_encoder*) encoder;
+    assert(e);
+    return e->block_size();
+}
+
+uint32_t kodoc_batch_encoder_coefficient_vector_size(
+    kodoc_batch_encoder_t encoder)
+{
+    auto e = (kodoc::batch_encoder*) encoder;
+    assert(e);
+    return e->coefficient_vector_size();
+}
+
+void kodoc_batch_encoder_set_const_symbols(
+    kodoc_batch_encoder_t encoder, const uint8_t* data, uint32_t size)
+{
+    auto e = (kodoc::batch_encoder*) encoder;
+    assert(e);
+    e->set_const_symbols(data, size);
+}
+
+uint32_t kodoc_batch_encoder_write_symbols(
+    kodoc_batch_encoder_t encoder, uint8_t* symbol_data,
+    uint8_t* coefficients, uint32_t count)
+{
+    auto e = (kodoc::batch_encoder*) encoder;
+    assert(e);
+    return e->write_symbols(symbol_data, coefficients, count);
+}
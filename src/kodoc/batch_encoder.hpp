@@ -0,0 +1,104 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "kodoc.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace kodoc
+{
+/// Encodes a block of symbols in the binary field, where a coded symbol is
+/// the xor of the source symbols with a set coefficient bit. A batch of
+/// coded symbols is computed in groups of up to max_group symbols, and
+/// every group reads the source symbols once, so the memory traffic of a
+/// batch is a fraction of encoding the symbols one by one. The symbols of
+/// a group are computed in tiles: a tile of every coded symbol is summed
+/// in a buffer that stays in the cache, while the same tile of each
+/// source symbol is read sequentially.
+class batch_encoder
+{
+public:
+
+    /// The maximum number of coded symbols that share a pass over the
+    /// source symbols
+    static const uint32_t max_group = 32;
+
+    /// The size of the buffer of the tiles of a group in bytes
+    static const uint32_t tile_buffer_size = 64 * 1024;
+
+    /// The size of the coded symbols of a batch from which they are
+    /// written with non-temporal stores, since they would only evict the
+    /// source symbols from the cache
+    static const uint32_t nontemporal_threshold = 1024 * 1024;
+
+    /// @param symbols The number of symbols in the block
+    /// @param symbol_size The size of a symbol in bytes
+    batch_encoder(uint32_t symbols, uint32_t symbol_size);
+
+    uint32_t symbols() const
+    {
+        return m_symbols;
+    }
+
+    uint32_t symbol_size() const
+    {
+        return m_symbol_size;
+    }
+
+    uint32_t block_size() const
+    {
+        return m_symbols * m_symbol_size;
+    }
+
+    uint32_t coefficient_vector_size() const
+    {
+        return (m_symbols + 7) / 8;
+    }
+
+    /// Sets the source symbols. The data is not copied, so it must stay
+    /// valid while the encoder is used.
+    void set_const_symbols(const uint8_t* data, uint32_t size);
+
+    /// Writes a batch of coded symbols with random coefficients
+    /// @param symbol_data The buffer of the coded symbols, which are
+    ///        stored back to back
+    /// @param coefficients The buffer of the coefficient vectors, which
+    ///        are stored back to back
+    /// @param count The number of coded symbols
+    /// @return The bytes used from the symbol buffer
+    uint32_t write_symbols(uint8_t* symbol_data, uint8_t* coefficients,
+                           uint32_t count);
+
+private:
+
+    /// Fills a coefficient vector with random bits, of which at least one
+    /// is set
+    void random_coefficients(uint8_t* coefficients);
+
+    /// Computes a group of coded symbols
+    void encode_group(uint8_t* symbol_data, uint32_t group,
+                      bool nontemporal);
+
+private:
+
+    uint32_t m_symbols;
+    uint32_t m_symbol_size;
+
+    const uint8_t* m_data;
+
+    /// The coefficients of a group of coded symbols per source symbol,
+    /// where bit k belongs to coded symbol k of the group
+    std::vector<uint32_t> m_selection;
+
+    /// The tiles of a group, aligned to a cache line
+    std::vector<uint8_t> m_tiles;
+
+    std::mt19937 m_random;
+};
+}
@@ -0,0 +1,96 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "kodoc.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+namespace kodoc
+{
+/// Object payloads start with the block id in big endian byte order.
+/// A coded payload continues with the payload produced by the coder of the
+/// block. During the systematic phase, the object encoder sends the source
+/// symbols itself: the uncoded_symbol_flag is set in the block id, and the
+/// header continues with the symbol index, followed by the source symbol.
+const uint32_t block_header_size = sizeof(uint32_t);
+const uint32_t uncoded_header_size = block_header_size + sizeof(uint32_t);
+const uint32_t uncoded_symbol_flag = 0x80000000U;
+
+inline void write_uint32(uint8_t* buffer, uint32_t value)
+{
+    buffer[0] = (uint8_t) (value >> 24);
+    buffer[1] = (uint8_t) (value >> 16);
+    buffer[2] = (uint8_t) (value >> 8);
+    buffer[3] = (uint8_t) value;
+}
+
+inline uint32_t read_uint32(const uint8_t* buffer)
+{
+    return ((uint32_t) buffer[0] << 24) | ((uint32_t) buffer[1] << 16) |
+           ((uint32_t) buffer[2] << 8) | (uint32_t) buffer[3];
+}
+
+inline void write_block_header(uint8_t* payload, uint32_t block)
+{
+    assert((block & uncoded_symbol_flag) == 0);
+    write_uint32(payload, block);
+}
+
+inline void write_uncoded_header(uint8_t* payload, uint32_t block,
+                                 uint32_t index)
+{
+    assert((block & uncoded_symbol_flag) == 0);
+    write_uint32(payload, block | uncoded_symbol_flag);
+    write_uint32(payload + block_header_size, index);
+}
+
+/// @return The block id of an object payload
+inline uint32_t read_block_header(const uint8_t* payload)
+{
+    return read_uint32(payload) & ~uncoded_symbol_flag;
+}
+
+/// @return true if the object payload contains an uncoded source symbol
+inline bool is_uncoded_symbol(const uint8_t* payload)
+{
+    return (read_uint32(payload) & uncoded_symbol_flag) != 0;
+}
+
+/// @return The maximum size of an object payload for blocks built with the
+///         given factory
+inline uint32_t max_object_payload_size(kodoc_factory_t factory)
+{
+    uint32_t coded = block_header_size +
+        kodoc_factory_max_payload_size(factory);
+    uint32_t uncoded = uncoded_header_size +
+        kodoc_factory_max_symbol_size(factory);
+
+    return std::max(coded, uncoded);
+}
+
+/// Passes an object payload to the decoder of its block
+inline void read_block_payload(kodoc_coder_t decoder, uint8_t* payload)
+{
+    if (!is_uncoded_symbol(payload))
+    {
+        kodoc_read_payload(decoder, payload + block_header_size);
+        return;
+    }
+
+    uint32_t index = read_uint32(payload + block_header_size);
+
+    // Repeated or invalid source symbols are ignored
+    if (index < kodoc_symbols(decoder) &&
+        !kodoc_is_symbol_uncoded(decoder, index))
+    {
+        kodoc_read_uncoded_symbol(
+            decoder, payload + uncoded_header_size, index);
+    }
+}
+}
@@ -0,0 +1,52 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "kodoc.h"
+
+#include <cassert>
+#include <cstdint>
+
+#include <kodo_core/api/api.hpp>
+
+#include "counters_binding.hpp"
+#include "recycle_binding.hpp"
+#include "snapshot_binding.hpp"
+
+/// The object behind a kodoc_coder_t handle. The optional interfaces of
+/// the coder are resolved once when the coder is built, so the hot API
+/// functions make a single virtual call instead of looking up the
+/// interface on every call. An interface pointer is nullptr if the coder
+/// does not implement it, and the capabilities hold the matching
+/// kodoc_capability flags.
+struct kodoc_coder
+{
+    explicit kodoc_coder(kodo_core::api::final_interface* the_api);
+
+    kodo_core::api::final_interface* api;
+    uint32_t capabilities;
+
+    kodo_core::api::payload_size_interface* payload_size;
+    kodo_core::api::read_payload_interface* read_payload;
+    kodo_core::api::write_payload_interface* write_payload;
+    kodo_core::api::rank_interface* rank;
+    kodo_core::api::decoder_interface* decoder;
+    kodo_core::api::partial_decoding_interface* partial_decoding;
+
+    kodoc::counters_interface* counters;
+    kodoc::recycle_interface* recycle;
+    kodoc::snapshot_interface* snapshot;
+};
+
+namespace kodoc
+{
+/// @return The coder behind a handle
+inline kodo_core::api::final_interface* coder_api(kodoc_coder_t coder)
+{
+    assert(coder);
+    return coder->api;
+}
+}
@@ -0,0 +1,96 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include "coder_pool.hpp"
+
+#include <cassert>
+#include <cstdint>
+
+#include "coder.hpp"
+#include "factory_cache.hpp"
+
+namespace kodoc
+{
+coder_pool::coder_pool(kodoc_factory_t factory) :
+    m_factory(factory)
+{
+    assert(m_factory);
+}
+
+coder_pool::~coder_pool()
+{
+    for (auto coder : m_idle)
+        kodoc_delete_coder(coder);
+}
+
+kodoc_coder_t coder_pool::acquire()
+{
+    if (m_idle.empty())
+        return kodoc_factory_build_coder(m_factory);
+
+    kodoc_coder_t coder = m_idle.back();
+    m_idle.pop_back();
+
+    recycle_coder(m_factory, coder);
+    return coder;
+}
+
+kodoc_coder_t coder_pool::acquire(uint32_t symbols, uint32_t symbol_size)
+{
+    kodoc_coder_t coder = nullptr;
+
+    if (!m_idle.empty())
+    {
+        coder = m_idle.back();
+        m_idle.pop_back();
+    }
+
+    return build_coder(m_factory, symbols, symbol_size, coder);
+}
+
+void coder_pool::release(kodoc_coder_t coder)
+{
+    assert(coder);
+    m_idle.push_back(coder);
+}
+}
+
+//------------------------------------------------------------------
+// CODER POOL API
+//------------------------------------------------------------------
+
+kodoc_coder_pool_t kodoc_new_coder_pool(kodoc_factory_t factory)
+{
+    assert(factory);
+    return (kodoc_coder_pool_t) new kodoc::coder_pool(factory);
+}
+
+void kodoc_delete_coder_pool(kodoc_coder_pool_t pool)
+{
+    auto coder_pool = (kodoc::coder_pool*) pool;
+    assert(coder_pool);
+    delete coder_pool;
+}
+
+kodoc_coder_t kodoc_coder_pool_acquire(kodoc_coder_pool_t pool)
+{
+    auto coder_pool = (kodoc::coder_pool*) pool;
+    assert(coder_pool);
+    return coder_pool->acquire();
+}
+
+void kodoc_coder_pool_release(kodoc_coder_pool_t pool, kodoc_coder_t coder)
+{
+    auto coder_pool = (kodoc::coder_pool*) pool;
+    assert(coder_pool);
+    coder_pool->release(coder);
+}
+
+uint32_t kodoc_coder_pool_idle(kodoc_coder_pool_t pool)
+{
+    auto coder_pool = (kodoc::coder_pool*) pool;
+    assert(coder_pool);
+    return coder_pool->idle();
+}
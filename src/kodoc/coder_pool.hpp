@@ -0,0 +1,55 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "kodoc.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace kodoc
+{
+/// Keeps released coders of a factory and hands them out again after
+/// re-initializing them, so that the memory of a coder is only allocated
+/// once.
+class coder_pool
+{
+public:
+
+    /// @param factory The factory used to build new coders. The factory
+    ///        must outlive the pool.
+    coder_pool(kodoc_factory_t factory);
+
+    /// Deletes all idle coders in the pool
+    ~coder_pool();
+
+    coder_pool(const coder_pool&) = delete;
+    coder_pool& operator=(const coder_pool&) = delete;
+
+    /// @return An idle coder that is re-initialized with the current
+    ///         factory settings, or a newly built coder if the pool is empty
+    kodoc_coder_t acquire();
+
+    /// @return An idle coder or a newly built coder for the given number of
+    ///         symbols and symbol size. The factory is set up and the coder
+    ///         is built in one step, see build_coder().
+    kodoc_coder_t acquire(uint32_t symbols, uint32_t symbol_size);
+
+    /// Returns a coder to the pool
+    void release(kodoc_coder_t coder);
+
+    /// @return The number of idle coders in the pool
+    uint32_t idle() const
+    {
+        return (uint32_t) m_idle.size();
+    }
+
+private:
+
+    kodoc_factory_t m_factory;
+    std::vector<kodoc_coder_t> m_idle;
+};
+}
@@ -0,0 +1,206 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "kodoc.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+#include <kodo_core/api/api.hpp>
+
+#include "event_ring.hpp"
+
+namespace kodoc
+{
+/// Interface for coders that count their payloads and the time spent in
+/// coding them, and that can record their operations as trace events
+struct counters_interface
+{
+    virtual ~counters_interface()
+    { }
+
+    /// @return The counters of the coder
+    virtual const kodoc_counters_t& counters() const = 0;
+
+    /// Sets all counters to zero
+    virtual void reset_counters() = 0;
+
+    /// Sets the ring that receives the trace events of the coder
+    /// @param events The event ring, or nullptr to stop recording events
+    virtual void set_event_ring(event_ring* events) = 0;
+};
+
+/// Keeps the counters in plain fields, which are only written by the
+/// thread that uses the coder. The counters are cleared and the event ring
+/// is detached whenever the coder is initialized by a factory.
+template<class Stack>
+class basic_counters_binding : public Stack, public virtual counters_interface
+{
+public:
+
+    template<class Factory>
+    void initialize(Factory& the_factory)
+    {
+        Stack::initialize(the_factory);
+        reset_counters();
+        m_events = nullptr;
+    }
+
+    const kodoc_counters_t& counters() const override
+    {
+        return m_counters;
+    }
+
+    void reset_counters() override
+    {
+        memset(&m_counters, 0, sizeof(m_counters));
+    }
+
+    void set_event_ring(event_ring* events) override
+    {
+        m_events = events;
+    }
+
+protected:
+
+    using clock = std::chrono::steady_clock;
+
+    static uint64_t nanoseconds(clock::time_point time)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            time.time_since_epoch()).count();
+    }
+
+    /// Records an event if an event ring is attached
+    void record(uint32_t type, uint32_t symbol, uint32_t bytes,
+                uint64_t timestamp)
+    {
+        if (m_events != nullptr)
+            m_events->push(type, symbol, Stack::rank(), bytes, timestamp);
+    }
+
+protected:
+
+    kodoc_counters_t m_counters;
+    event_ring* m_events = nullptr;
+};
+
+/// Counts the payloads written by an encoder. While the systematic phase
+/// is active, the encoder sends every source symbol once before it starts
+/// sending coded symbols, which is tracked in the same way here.
+template<class Stack>
+class encoder_counters_binding : public basic_counters_binding<Stack>
+{
+public:
+
+    using Super = basic_counters_binding<Stack>;
+
+    template<class Factory>
+    void initialize(Factory& the_factory)
+    {
+        Super::initialize(the_factory);
+
+        m_systematic =
+            dynamic_cast<kodo_core::api::systematic_interface*>(this);
+        m_systematic_index = 0;
+    }
+
+    uint32_t write_payload(uint8_t* payload) override
+    {
+        bool systematic = m_systematic != nullptr &&
+            m_systematic->is_systematic_on() &&
+            m_systematic_index < Stack::rank();
+
+        uint64_t start = Super::nanoseconds(Super::clock::now());
+        uint32_t bytes_used = Stack::write_payload(payload);
+        uint64_t stop = Super::nanoseconds(Super::clock::now());
+
+        Super::m_counters.encode_nanoseconds += stop - start;
+        ++Super::m_counters.payloads_written;
+
+        uint32_t symbol = KODOC_NO_SYMBOL;
+
+        if (systematic)
+        {
+            ++Super::m_counters.systematic_sent;
+            symbol = m_systematic_index++;
+        }
+        else
+        {
+            ++Super::m_counters.coded_sent;
+        }
+
+        Super::record(kodoc_event_payload_written, symbol, bytes_used, stop);
+        return bytes_used;
+    }
+
+private:
+
+    kodo_core::api::systematic_interface* m_systematic = nullptr;
+    uint32_t m_systematic_index = 0;
+};
+
+/// Counts the payloads read by a decoder. A payload that does not increase
+/// the rank of the decoder is counted as linearly dependent.
+template<class Stack>
+class decoder_counters_binding : public basic_counters_binding<Stack>
+{
+public:
+
+    using Super = basic_counters_binding<Stack>;
+
+    void read_payload(uint8_t* payload) override
+    {
+        uint32_t rank = Stack::rank();
+
+        uint64_t start = Super::nanoseconds(Super::clock::now());
+        Stack::read_payload(payload);
+        uint64_t stop = Super::nanoseconds(Super::clock::now());
+
+        Super::m_counters.decode_nanoseconds += stop - start;
+        ++Super::m_counters.payloads_read;
+
+        if (Stack::rank() == rank)
+        {
+            ++Super::m_counters.linearly_dependent;
+            Super::record(kodoc_event_dependent_payload_read,
+                          KODOC_NO_SYMBOL, 0, stop);
+            return;
+        }
+
+        Super::record(kodoc_event_payload_read, KODOC_NO_SYMBOL, 0, stop);
+        record_complete(stop);
+    }
+
+    void read_uncoded_symbol(uint8_t* symbol_data, uint32_t index) override
+    {
+        uint32_t rank = Stack::rank();
+        Stack::read_uncoded_symbol(symbol_data, index);
+
+        if (Super::m_events == nullptr)
+            return;
+
+        uint64_t stop = Super::nanoseconds(Super::clock::now());
+        Super::record(kodoc_event_uncoded_symbol_read, index, 0, stop);
+
+        if (Stack::rank() != rank)
+            record_complete(stop);
+    }
+
+private:
+
+    void record_complete(uint64_t timestamp)
+    {
+        if (Stack::is_complete())
+        {
+            Super::record(kodoc_event_decoding_complete, KODOC_NO_SYMBOL, 0,
+                          timestamp);
+        }
+    }
+};
+}
@@ -7,24 +7,44 @@
 
 #include "kodoc.h"
 
+#include <cassert>
 #include <cstdint>
-#include <map>
 #include <string>
 
-template<class Runtime>
-kodoc_factory_t create_factory(int32_t finite_field, uint32_t max_symbols,
-                               uint32_t max_symbol_size)
+/// @param finite_field The finite field enum value
+/// @return The name of the finite field as expected by the runtime stacks,
+///         or "unknown" for a value that is not a finite field. The names
+///         are indexed by the kodoc_finite_field values, so the lookup
+///         does not allocate or compare any strings.
+inline const std::string& finite_field_name(int32_t finite_field)
 {
-    std::map<int32_t, std::string> finite_field_map =
+    static const std::string names[] =
         {
-            {kodoc_binary, "binary"},
-            {kodoc_binary4, "binary4"},
-            {kodoc_binary8, "binary8"}
+            "binary",  // kodoc_binary
+            "binary4", // kodoc_binary4
+            "binary8"  // kodoc_binary8
         };
 
-    auto r = Runtime();
+    static const std::string unknown = "unknown";
+
+    assert(finite_field >= kodoc_binary && finite_field <= kodoc_binary8 &&
+           "Unknown finite field");
+
+    // The assert is compiled out of release builds, where the table must
+    // still not be read out of bounds
+    if (finite_field < kodoc_binary || finite_field > kodoc_binary8)
+        return unknown;
+
+    return names[finite_field];
+}
+
+template<class Runtime>
+kodoc_factory_t create_factory(int32_t finite_field, uint32_t max_symbols,
+                               uint32_t max_symbol_size)
+{
+    Runtime r;
 
-    r.set_field(finite_field_map[finite_field]);
+    r.set_field(finite_field_name(finite_field));
 
     auto f = r.build(max_symbols, max_symbol_size);
 
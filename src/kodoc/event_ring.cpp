@@ -0,0 +1,150 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include "event_ring.hpp"
+
+#include <cassert>
+#include <cstdint>
+
+#include "coder.hpp"
+
+namespace kodoc
+{
+event_ring::event_ring(uint32_t capacity) :
+    m_head(0),
+    m_tail(0),
+    m_dropped(0)
+{
+    assert(capacity > 0);
+    assert(capacity <= (1U << 31));
+
+    uint32_t size = 1;
+    while (size < capacity)
+        size <<= 1;
+
+    m_mask = size - 1;
+    m_slots.reset(new slot[size]);
+
+    for (uint32_t i = 0; i < size; ++i)
+        m_slots[i].m_sequence.store(0, std::memory_order_relaxed);
+}
+
+void event_ring::push(uint32_t type, uint32_t symbol, uint32_t rank,
+                      uint32_t bytes, uint64_t timestamp)
+{
+    uint64_t position = m_head.load(std::memory_order_relaxed);
+    slot& s = m_slots[position & m_mask];
+
+    // An odd sequence marks the slot as being written
+    s.m_sequence.store(2 * position + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    s.m_timestamp.store(timestamp, std::memory_order_relaxed);
+    s.m_type_symbol.store(((uint64_t) type << 32) | symbol,
+                          std::memory_order_relaxed);
+    s.m_rank_bytes.store(((uint64_t) rank << 32) | bytes,
+                         std::memory_order_relaxed);
+
+    s.m_sequence.store(2 * position + 2, std::memory_order_release);
+    m_head.store(position + 1, std::memory_order_release);
+}
+
+uint32_t event_ring::read(kodoc_event_t* events, uint32_t max_events)
+{
+    assert(events || max_events == 0);
+
+    uint64_t head = m_head.load(std::memory_order_acquire);
+    uint32_t count = 0;
+
+    while (count < max_events && m_tail < head)
+    {
+        // Skip the events that were already overwritten
+        if (head - m_tail > capacity())
+        {
+            m_dropped += head - capacity() - m_tail;
+            m_tail = head - capacity();
+        }
+
+        const slot& s = m_slots[m_tail & m_mask];
+        uint64_t expected = 2 * m_tail + 2;
+
+        uint64_t before = s.m_sequence.load(std::memory_order_acquire);
+        uint64_t timestamp = s.m_timestamp.load(std::memory_order_relaxed);
+        uint64_t type_symbol =
+            s.m_type_symbol.load(std::memory_order_relaxed);
+        uint64_t rank_bytes = s.m_rank_bytes.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t after = s.m_sequence.load(std::memory_order_relaxed);
+
+        if (before != expected || after != expected)
+        {
+            // The producer has lapped the consumer while the slot was read
+            ++m_dropped;
+            ++m_tail;
+            head = m_head.load(std::memory_order_acquire);
+            continue;
+        }
+
+        kodoc_event_t& e = events[count];
+        e.timestamp = timestamp;
+        e.type = (uint32_t) (type_symbol >> 32);
+        e.symbol = (uint32_t) type_symbol;
+        e.rank = (uint32_t) (rank_bytes >> 32);
+        e.bytes = (uint32_t) rank_bytes;
+
+        ++count;
+        ++m_tail;
+    }
+
+    return count;
+}
+}
+
+//------------------------------------------------------------------
+// EVENT RING API
+//------------------------------------------------------------------
+
+kodoc_event_ring_t kodoc_new_event_ring(uint32_t capacity)
+{
+    assert(capacity > 0);
+    return (kodoc_event_ring_t) new kodoc::event_ring(capacity);
+}
+
+void kodoc_delete_event_ring(kodoc_event_ring_t ring)
+{
+    auto event_ring = (kodoc::event_ring*) ring;
+    assert(event_ring);
+    delete event_ring;
+}
+
+uint32_t kodoc_event_ring_capacity(kodoc_event_ring_t ring)
+{
+    auto event_ring = (kodoc::event_ring*) ring;
+    assert(event_ring);
+    return event_ring->capacity();
+}
+
+uint32_t kodoc_read_events(kodoc_event_ring_t ring, kodoc_event_t* events,
+                           uint32_t max_events)
+{
+    auto event_ring = (kodoc::event_ring*) ring;
+    assert(event_ring);
+    return event_ring->read(events, max_events);
+}
+
+uint64_t kodoc_event_ring_dropped(kodoc_event_ring_t ring)
+{
+    auto event_ring = (kodoc::event_ring*) ring;
+    assert(event_ring);
+    return event_ring->dropped();
+}
+
+void kodoc_set_event_ring(kodoc_coder_t coder, kodoc_event_ring_t ring)
+{
+    assert(coder);
+    assert(coder->counters);
+
+    coder->counters->set_event_ring((kodoc::event_ring*) ring);
+}
@@ -0,0 +1,82 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "kodoc.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace kodoc
+{
+/// Lock-free ring of fixed-size trace events with a single producer (the
+/// thread that uses the coder) and a single consumer. The producer never
+/// waits: when the ring is full, the oldest event is overwritten, so the
+/// ring always holds the latest events for a post-mortem.
+///
+/// Every slot carries a sequence number that is odd while the slot is
+/// written, in the style of a seqlock. The consumer checks the sequence
+/// before and after copying a slot, and skips the events that were
+/// overwritten in the meantime.
+class event_ring
+{
+public:
+
+    /// @param capacity The minimum number of events, which is rounded up
+    ///        to a power of two
+    explicit event_ring(uint32_t capacity);
+
+    event_ring(const event_ring&) = delete;
+    event_ring& operator=(const event_ring&) = delete;
+
+    /// @return The number of events that the ring can hold
+    uint32_t capacity() const
+    {
+        return m_mask + 1;
+    }
+
+    /// Appends an event. Must only be called by the producer.
+    void push(uint32_t type, uint32_t symbol, uint32_t rank, uint32_t bytes,
+              uint64_t timestamp);
+
+    /// Copies the oldest unread events in the order they were pushed.
+    /// Must only be called by the consumer.
+    /// @return The number of events copied
+    uint32_t read(kodoc_event_t* events, uint32_t max_events);
+
+    /// @return The number of events that were overwritten before the
+    ///         consumer read them
+    uint64_t dropped() const
+    {
+        return m_dropped;
+    }
+
+private:
+
+    /// The event fields are packed in atomic words, so that a slot can be
+    /// read while the producer overwrites it
+    struct slot
+    {
+        std::atomic<uint64_t> m_sequence;
+        std::atomic<uint64_t> m_timestamp;
+        std::atomic<uint64_t> m_type_symbol;
+        std::atomic<uint64_t> m_rank_bytes;
+    };
+
+private:
+
+    uint32_t m_mask;
+    std::unique_ptr<slot[]> m_slots;
+
+    /// The position of the next event, written by the producer
+    std::atomic<uint64_t> m_head;
+
+    /// The position of the next unread event, owned by the consumer
+    uint64_t m_tail;
+    uint64_t m_dropped;
+};
+}
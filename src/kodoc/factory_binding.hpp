@@ -7,11 +7,14 @@
 
 #include <kodo_core/api/api.hpp>
 
+#include "allocator_binding.hpp"
+
 namespace kodoc
 {
 template<class Factory>
 using factory_binding =
+    allocator_binding<
     kodo_core::api::storage_block_info_binding<
     kodo_core::api::max_payload_size_binding<
-    kodo_core::api::final_binding<Factory>>>;
+    kodo_core::api::final_binding<Factory>>>>;
 }
@@ -0,0 +1,191 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include "factory_cache.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace kodoc
+{
+namespace
+{
+/// The parameters that identify a shared factory
+struct factory_key
+{
+    bool encoder;
+    int32_t codec;
+    int32_t finite_field;
+    uint32_t max_symbols;
+    uint32_t max_symbol_size;
+
+    bool operator==(const factory_key& other) const
+    {
+        return encoder == other.encoder && codec == other.codec &&
+               finite_field == other.finite_field &&
+               max_symbols == other.max_symbols &&
+               max_symbol_size == other.max_symbol_size;
+    }
+};
+
+struct factory_key_hash
+{
+    std::size_t operator()(const factory_key& key) const
+    {
+        uint64_t value = ((uint64_t) key.max_symbols << 32) ^
+                         key.max_symbol_size;
+        value ^= ((uint64_t) key.codec << 40) ^
+                 ((uint64_t) key.finite_field << 56) ^
+                 (uint64_t) key.encoder << 63;
+
+        return std::hash<uint64_t>()(value);
+    }
+};
+
+struct factory_entry
+{
+    kodoc_factory_t factory;
+    uint32_t references;
+
+    /// Serializes the users of the shared factory
+    std::shared_ptr<std::mutex> mutex;
+};
+
+/// Process-wide table of shared factories. Every factory is found both by
+/// its parameters (when acquired) and by its handle (when released).
+class factory_cache
+{
+public:
+
+    factory_cache() :
+        m_size(0)
+    { }
+
+    std::shared_ptr<std::mutex> mutex(kodoc_factory_t factory)
+    {
+        // Most processes never share a factory, so the table is not
+        // searched while it is empty
+        if (m_size == 0)
+            return nullptr;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto key = m_keys.find(factory);
+        if (key == m_keys.end())
+            return nullptr;
+
+        return m_entries.at(key->second).mutex;
+    }
+
+    kodoc_factory_t acquire(const factory_key& key)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto it = m_entries.find(key);
+        if (it != m_entries.end())
+        {
+            ++it->second.references;
+            return it->second.factory;
+        }
+
+        kodoc_factory_t factory = key.encoder ?
+            kodoc_new_encoder_factory(key.codec, key.finite_field,
+                                      key.max_symbols, key.max_symbol_size) :
+            kodoc_new_decoder_factory(key.codec, key.finite_field,
+                                      key.max_symbols, key.max_symbol_size);
+
+        if (factory == 0)
+            return 0;
+
+        m_entries[key] =
+            factory_entry{factory, 1, std::make_shared<std::mutex>()};
+        m_keys[factory] = key;
+        ++m_size;
+
+        return factory;
+    }
+
+    void release(kodoc_factory_t factory)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto key = m_keys.find(factory);
+        assert(key != m_keys.end() && "The factory was not acquired");
+
+        auto entry = m_entries.find(key->second);
+        assert(entry != m_entries.end());
+        assert(entry->second.references > 0);
+
+        if (--entry->second.references > 0)
+            return;
+
+        m_entries.erase(entry);
+        m_keys.erase(key);
+        --m_size;
+
+        kodoc_delete_factory(factory);
+    }
+
+private:
+
+    std::mutex m_mutex;
+    std::unordered_map<factory_key, factory_entry, factory_key_hash>
+        m_entries;
+    std::unordered_map<kodoc_factory_t, factory_key> m_keys;
+
+    /// The number of shared factories, which is read without the lock
+    std::atomic<uint32_t> m_size;
+};
+
+factory_cache& cache()
+{
+    // Constructed on first use so that the cache can be used from the
+    // constructors of other static objects
+    static factory_cache instance;
+    return instance;
+}
+}
+
+std::shared_ptr<std::mutex> shared_factory_mutex(kodoc_factory_t factory)
+{
+    return cache().mutex(factory);
+}
+}
+
+//------------------------------------------------------------------
+// FACTORY CACHE API
+//------------------------------------------------------------------
+
+kodoc_factory_t kodoc_acquire_encoder_factory(
+    int32_t codec, int32_t finite_field,
+    uint32_t max_symbols, uint32_t max_symbol_size)
+{
+    kodoc::factory_key key =
+        {true, codec, finite_field, max_symbols, max_symbol_size};
+
+    return kodoc::cache().acquire(key);
+}
+
+kodoc_factory_t kodoc_acquire_decoder_factory(
+    int32_t codec, int32_t finite_field,
+    uint32_t max_symbols, uint32_t max_symbol_size)
+{
+    kodoc::factory_key key =
+        {false, codec, finite_field, max_symbols, max_symbol_size};
+
+    return kodoc::cache().acquire(key);
+}
+
+void kodoc_release_factory(kodoc_factory_t factory)
+{
+    assert(factory);
+    kodoc::cache().release(factory);
+}
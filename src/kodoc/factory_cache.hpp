@@ -0,0 +1,61 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "kodoc.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace kodoc
+{
+/// @return The mutex that serializes the calls that change or build from a
+///         factory of the factory cache, or null if the factory is not
+///         shared. The mutex stays valid while the pointer is held.
+std::shared_ptr<std::mutex> shared_factory_mutex(kodoc_factory_t factory);
+
+/// Holds the mutex of a shared factory, and does nothing for a factory
+/// that is not shared
+class shared_factory_lock
+{
+public:
+
+    explicit shared_factory_lock(kodoc_factory_t factory) :
+        m_mutex(shared_factory_mutex(factory))
+    {
+        if (m_mutex)
+            m_mutex->lock();
+    }
+
+    ~shared_factory_lock()
+    {
+        if (m_mutex)
+            m_mutex->unlock();
+    }
+
+    shared_factory_lock(const shared_factory_lock&) = delete;
+    shared_factory_lock& operator=(const shared_factory_lock&) = delete;
+
+private:
+
+    std::shared_ptr<std::mutex> m_mutex;
+};
+
+/// Sets the number of symbols and the symbol size of a factory and builds
+/// a coder with them, or re-initializes an idle coder with them. The lock
+/// of a shared factory is held across all steps, so another user of the
+/// factory cannot change the settings before the coder is built.
+/// @param idle A coder built by the factory that is reused, or nullptr to
+///        build a new coder
+/// @return The coder, which is the idle coder if it was given
+kodoc_coder_t build_coder(kodoc_factory_t factory, uint32_t symbols,
+                          uint32_t symbol_size, kodoc_coder_t idle);
+
+/// Re-initializes a coder with the current settings of the factory that
+/// built it, while holding the lock of a shared factory
+void recycle_coder(kodoc_factory_t factory, kodoc_coder_t coder);
+}
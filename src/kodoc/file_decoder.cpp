@@ -0,0 +1,107 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include "file_decoder.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <utility>
+
+namespace kodoc
+{
+file_decoder::file_decoder(
+    kodoc_factory_t factory, std::unique_ptr<mapped_file> file) :
+    m_file(std::move(file)),
+    m_object(factory, m_file->data(), m_file->size())
+{ }
+
+uint32_t file_decoder::read_payload(uint8_t* payload)
+{
+    const kodoc::partitioning& p = m_object.partitioning();
+    uint32_t completed = m_object.completed_blocks();
+
+    uint32_t block = m_object.read_payload(payload);
+
+    // The decoded block is in the page cache, so it no longer needs to be
+    // mapped into the process
+    if (m_object.completed_blocks() != completed)
+    {
+        assert(block < p.blocks());
+        m_file->dont_need(p.offset(block), p.bytes(block));
+    }
+
+    return block;
+}
+}
+
+//------------------------------------------------------------------
+// FILE DECODER API
+//------------------------------------------------------------------
+
+kodoc_file_decoder_t kodoc_file_decoder_open(
+    kodoc_factory_t factory, const char* path, uint64_t size)
+{
+    assert(factory);
+    assert(path);
+    assert(size > 0);
+
+    std::unique_ptr<kodoc::mapped_file> file(new kodoc::mapped_file());
+    if (!file->open_write(path, size))
+        return 0;
+
+    return (kodoc_file_decoder_t) new kodoc::file_decoder(
+        factory, std::move(file));
+}
+
+void kodoc_file_decoder_close(kodoc_file_decoder_t decoder)
+{
+    auto file = (kodoc::file_decoder*) decoder;
+    assert(file);
+    delete file;
+}
+
+uint64_t kodoc_file_decoder_file_size(kodoc_file_decoder_t decoder)
+{
+    auto file = (kodoc::file_decoder*) decoder;
+    assert(file);
+    return file->size();
+}
+
+uint32_t kodoc_file_decoder_blocks(kodoc_file_decoder_t decoder)
+{
+    auto file = (kodoc::file_decoder*) decoder;
+    assert(file);
+    return file->object().partitioning().blocks();
+}
+
+uint32_t kodoc_file_decoder_payload_size(kodoc_file_decoder_t decoder)
+{
+    auto file = (kodoc::file_decoder*) decoder;
+    assert(file);
+    return file->object().payload_size();
+}
+
+uint32_t kodoc_file_decoder_read_payload(
+    kodoc_file_decoder_t decoder, uint8_t* payload)
+{
+    auto file = (kodoc::file_decoder*) decoder;
+    assert(file);
+    return file->read_payload(payload);
+}
+
+uint8_t kodoc_file_decoder_is_block_complete(
+    kodoc_file_decoder_t decoder, uint32_t block)
+{
+    auto file = (kodoc::file_decoder*) decoder;
+    assert(file);
+    return file->object().is_block_complete(block);
+}
+
+uint8_t kodoc_file_decoder_is_complete(kodoc_file_decoder_t decoder)
+{
+    auto file = (kodoc::file_decoder*) decoder;
+    assert(file);
+    return file->object().is_complete();
+}
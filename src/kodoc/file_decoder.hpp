@@ -0,0 +1,53 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "kodoc.h"
+
+#include <cstdint>
+#include <memory>
+
+#include "mapped_file.hpp"
+#include "object_decoder.hpp"
+
+namespace kodoc
+{
+/// Decodes directly into a file that is mapped into memory. The block
+/// decoders use the mapped pages as their symbol storage, and the pages of
+/// a block are dropped from the resident set when the block is complete,
+/// so large files can be decoded with a small memory footprint.
+class file_decoder
+{
+public:
+
+    /// @param factory The decoder factory used to build the block decoders
+    /// @param file The mapped file, which is owned by the file decoder
+    file_decoder(kodoc_factory_t factory, std::unique_ptr<mapped_file> file);
+
+    /// @return The object decoder of the file
+    object_decoder& object()
+    {
+        return m_object;
+    }
+
+    /// @return The size of the file in bytes
+    uint64_t size() const
+    {
+        return m_file->size();
+    }
+
+    /// Reads a payload and passes it to the decoder of its block
+    /// @return The block index of the payload
+    uint32_t read_payload(uint8_t* payload);
+
+private:
+
+    /// The file is declared first, so it is unmapped after the coders are
+    /// deleted
+    std::unique_ptr<mapped_file> m_file;
+    object_decoder m_object;
+};
+}
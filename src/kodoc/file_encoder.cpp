@@ -0,0 +1,111 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include "file_encoder.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <utility>
+
+namespace kodoc
+{
+file_encoder::file_encoder(
+    kodoc_factory_t factory, std::unique_ptr<mapped_file> file) :
+    m_file(std::move(file)),
+    m_object(factory, m_file->data(), m_file->size()),
+    m_started(m_object.partitioning().blocks(), 0)
+{
+    const kodoc::partitioning& p = m_object.partitioning();
+    m_file->will_need(p.offset(0), p.bytes(0));
+}
+
+uint32_t file_encoder::write_payload(uint32_t block, uint8_t* payload)
+{
+    assert(block < m_started.size());
+
+    if (!m_started[block])
+    {
+        m_started[block] = 1;
+
+        // Blocks are typically sent in order, so the next block is read in
+        // while this one is being encoded
+        const kodoc::partitioning& p = m_object.partitioning();
+        uint32_t next = block + 1;
+
+        if (next < p.blocks())
+            m_file->will_need(p.offset(next), p.bytes(next));
+
+        // The previous block is finished, so its pages no longer need to
+        // be mapped into the process. They stay in the page cache, so a
+        // late payload for that block only maps them in again.
+        if (block > 0 && m_started[block - 1])
+            m_file->dont_need(p.offset(block - 1), p.bytes(block - 1));
+    }
+
+    return m_object.write_payload(block, payload);
+}
+}
+
+//------------------------------------------------------------------
+// FILE ENCODER API
+//------------------------------------------------------------------
+
+kodoc_file_encoder_t kodoc_file_encoder_open(
+    kodoc_factory_t factory, const char* path)
+{
+    assert(factory);
+    assert(path);
+
+    std::unique_ptr<kodoc::mapped_file> file(new kodoc::mapped_file());
+    if (!file->open_read(path))
+        return 0;
+
+    return (kodoc_file_encoder_t) new kodoc::file_encoder(
+        factory, std::move(file));
+}
+
+void kodoc_file_encoder_close(kodoc_file_encoder_t encoder)
+{
+    auto file = (kodoc::file_encoder*) encoder;
+    assert(file);
+    delete file;
+}
+
+uint64_t kodoc_file_encoder_file_size(kodoc_file_encoder_t encoder)
+{
+    auto file = (kodoc::file_encoder*) encoder;
+    assert(file);
+    return file->size();
+}
+
+uint32_t kodoc_file_encoder_blocks(kodoc_file_encoder_t encoder)
+{
+    auto file = (kodoc::file_encoder*) encoder;
+    assert(file);
+    return file->object().partitioning().blocks();
+}
+
+uint32_t kodoc_file_encoder_payload_size(kodoc_file_encoder_t encoder)
+{
+    auto file = (kodoc::file_encoder*) encoder;
+    assert(file);
+    return file->object().payload_size();
+}
+
+kodoc_coder_t kodoc_file_encoder_coder(
+    kodoc_file_encoder_t encoder, uint32_t block)
+{
+    auto file = (kodoc::file_encoder*) encoder;
+    assert(file);
+    return file->object().coder(block);
+}
+
+uint32_t kodoc_file_encoder_write_payload(
+    kodoc_file_encoder_t encoder, uint32_t block, uint8_t* payload)
+{
+    auto file = (kodoc::file_encoder*) encoder;
+    assert(file);
+    return file->write_payload(block, payload);
+}
@@ -0,0 +1,58 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "kodoc.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "mapped_file.hpp"
+#include "object_encoder.hpp"
+
+namespace kodoc
+{
+/// Encodes a file that is mapped into memory. The block encoders use the
+/// mapped pages as their symbol storage, so the file is never copied. When
+/// a block is first encoded, the pages of the next block are prefetched
+/// and the pages of the previous block are released.
+class file_encoder
+{
+public:
+
+    /// @param factory The encoder factory used to build the block encoders
+    /// @param file The mapped file, which is owned by the file encoder
+    file_encoder(kodoc_factory_t factory, std::unique_ptr<mapped_file> file);
+
+    /// @return The object encoder of the file
+    object_encoder& object()
+    {
+        return m_object;
+    }
+
+    /// @return The size of the file in bytes
+    uint64_t size() const
+    {
+        return m_file->size();
+    }
+
+    /// Writes a payload for the given block
+    /// @return The total bytes used from the payload buffer
+    uint32_t write_payload(uint32_t block, uint8_t* payload);
+
+private:
+
+    /// The file is declared first, so it is unmapped after the coders are
+    /// deleted
+    std::unique_ptr<mapped_file> m_file;
+    object_encoder m_object;
+
+    /// Tracks the blocks that have been encoded, so that the next block is
+    /// only prefetched and the previous block only released once
+    std::vector<uint8_t> m_started;
+};
+}
@@ -0,0 +1,277 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include "finite_field.hpp"
+#include "simd.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
+namespace kodoc
+{
+namespace
+{
+// Multiplies two elements with the shift-and-add method, where the product
+// is reduced by the given polynomial (without its top bit)
+uint8_t slow_multiply(uint8_t a, uint8_t b, uint32_t degree,
+                      uint8_t polynomial)
+{
+    uint8_t high_bit = (uint8_t)(1U << (degree - 1));
+    uint8_t mask = (uint8_t)((1U << degree) - 1);
+    uint8_t product = 0;
+
+    while (b)
+    {
+        if (b & 1)
+            product ^= a;
+
+        bool carry = (a & high_bit) != 0;
+        a = (uint8_t)((a << 1) & mask);
+        if (carry)
+            a ^= polynomial;
+
+        b >>= 1;
+    }
+    return product;
+}
+
+/// The binary8 multiplication table, where the row of a constant maps
+/// every element to its product with the constant. The nibble table of a
+/// constant holds the products of the low and the high nibble values.
+struct binary8_table
+{
+    binary8_table()
+    {
+        for (uint32_t a = 0; a < 256; ++a)
+        {
+            for (uint32_t b = 0; b < 256; ++b)
+                m_product[a][b] = slow_multiply(a, b, 8, 0x1D);
+
+            for (uint32_t b = 0; b < 16; ++b)
+            {
+                m_nibbles[a][b] = m_product[a][b];
+                m_nibbles[a][16 + b] = m_product[a][b << 4];
+            }
+        }
+    }
+
+    uint8_t m_product[256][256];
+    uint8_t m_nibbles[256][32];
+};
+
+/// The binary4 multiplication tables. The byte table of a constant maps a
+/// byte with two packed elements to the byte with both products, and the
+/// nibble table holds the products of the low and the high element.
+struct binary4_table
+{
+    binary4_table()
+    {
+        for (uint32_t a = 0; a < 16; ++a)
+        {
+            for (uint32_t b = 0; b < 16; ++b)
+                m_product[a][b] = slow_multiply(a, b, 4, 0x03);
+        }
+
+        for (uint32_t a = 0; a < 16; ++a)
+        {
+            for (uint32_t b = 0; b < 256; ++b)
+            {
+                m_packed[a][b] = (uint8_t)(m_product[a][b & 0x0F] |
+                    (m_product[a][b >> 4] << 4));
+            }
+
+            for (uint32_t b = 0; b < 16; ++b)
+            {
+                m_nibbles[a][b] = m_product[a][b];
+                m_nibbles[a][16 + b] = (uint8_t)(m_product[a][b] << 4);
+            }
+        }
+    }
+
+    uint8_t m_product[16][16];
+    uint8_t m_packed[16][256];
+    uint8_t m_nibbles[16][32];
+};
+
+// The tables are built on first use, which is thread-safe since C++11
+const binary8_table& binary8()
+{
+    static const binary8_table table;
+    return table;
+}
+
+const binary4_table& binary4()
+{
+    static const binary4_table table;
+    return table;
+}
+
+multiply_table constant_table(int32_t field, uint8_t constant)
+{
+    if (field == kodoc_binary4)
+    {
+        return { binary4().m_packed[constant],
+                 binary4().m_nibbles[constant] };
+    }
+
+    return { binary8().m_product[constant], binary8().m_nibbles[constant] };
+}
+}
+
+finite_field::finite_field(int32_t field) :
+    m_field(field)
+{
+    assert(m_field == kodoc_binary || m_field == kodoc_binary4 ||
+           m_field == kodoc_binary8);
+
+    // Build the tables up front, so the first coding operation is not
+    // delayed by it
+    if (m_field == kodoc_binary4)
+        binary4();
+    else if (m_field == kodoc_binary8)
+        binary8();
+}
+
+uint8_t finite_field::max_value() const
+{
+    switch (m_field)
+    {
+    case kodoc_binary:
+        return 1;
+    case kodoc_binary4:
+        return 15;
+    default:
+        return 255;
+    }
+}
+
+uint32_t finite_field::elements_to_size(uint32_t elements) const
+{
+    switch (m_field)
+    {
+    case kodoc_binary:
+        return (elements + 7) / 8;
+    case kodoc_binary4:
+        return (elements + 1) / 2;
+    default:
+        return elements;
+    }
+}
+
+uint8_t finite_field::get_value(const uint8_t* elements,
+                                uint32_t index) const
+{
+    switch (m_field)
+    {
+    case kodoc_binary:
+        return (elements[index / 8] >> (index % 8)) & 0x01;
+    case kodoc_binary4:
+        return (elements[index / 2] >> ((index % 2) * 4)) & 0x0F;
+    default:
+        return elements[index];
+    }
+}
+
+void finite_field::set_value(uint8_t* elements, uint32_t index,
+                             uint8_t value) const
+{
+    assert(value <= max_value());
+
+    switch (m_field)
+    {
+    case kodoc_binary:
+    {
+        uint8_t mask = (uint8_t)(1U << (index % 8));
+        elements[index / 8] = (uint8_t)((elements[index / 8] & ~mask) |
+            (value ? mask : 0));
+        break;
+    }
+    case kodoc_binary4:
+    {
+        uint32_t shift = (index % 2) * 4;
+        elements[index / 2] = (uint8_t)(
+            (elements[index / 2] & ~(0x0F << shift)) | (value << shift));
+        break;
+    }
+    default:
+        elements[index] = value;
+        break;
+    }
+}
+
+uint8_t finite_field::multiply(uint8_t a, uint8_t b) const
+{
+    assert(a <= max_value());
+    assert(b <= max_value());
+
+    switch (m_field)
+    {
+    case kodoc_binary:
+        return a & b;
+    case kodoc_binary4:
+        return binary4().m_product[a][b];
+    default:
+        return binary8().m_product[a][b];
+    }
+}
+
+uint8_t finite_field::invert(uint8_t a) const
+{
+    assert(a != 0);
+    assert(a <= max_value());
+
+    // The inverse is only needed once per pivot, so a search of the
+    // multiplication table is fast enough
+    for (uint32_t b = 1; b <= max_value(); ++b)
+    {
+        if (multiply(a, (uint8_t) b) == 1)
+            return (uint8_t) b;
+    }
+
+    assert(0 && "Every non-zero element has an inverse");
+    return 0;
+}
+
+void finite_field::region_multiply_add(uint8_t* dest, const uint8_t* src,
+                                       uint8_t constant,
+                                       uint32_t size) const
+{
+    assert(dest);
+    assert(src);
+    assert(constant <= max_value());
+
+    if (constant == 0)
+        return;
+
+    // Adding the source is an xor in all binary extension fields
+    if (constant == 1 || m_field == kodoc_binary)
+    {
+        simd().region_add(dest, src, size);
+        return;
+    }
+
+    simd().region_multiply_add(dest, src, constant_table(m_field, constant),
+                               size);
+}
+
+void finite_field::region_multiply(uint8_t* dest, uint8_t constant,
+                                   uint32_t size) const
+{
+    assert(dest);
+    assert(constant <= max_value());
+
+    if (constant == 1)
+        return;
+
+    if (constant == 0)
+    {
+        memset(dest, 0, size);
+        return;
+    }
+
+    simd().region_multiply(dest, constant_table(m_field, constant), size);
+}
+}
@@ -0,0 +1,71 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "kodoc.h"
+
+#include <cstdint>
+
+namespace kodoc
+{
+/// Arithmetic on packed vectors of finite field elements, for the parts of
+/// kodo-c that operate on symbols and coefficient vectors outside of a
+/// coder. The memory layout matches the coefficient vectors of the coders:
+///
+///  - binary: 8 elements per byte, the first element in the lowest bit
+///  - binary4: 2 elements per byte, the first element in the low nibble
+///  - binary8: 1 element per byte
+///
+/// The binary4 field uses the polynomial x^4 + x + 1 and the binary8 field
+/// uses x^8 + x^4 + x^3 + x^2 + 1, like the coders. The region operations
+/// run on the kernels that are selected for the CPU, see simd.hpp.
+class finite_field
+{
+public:
+
+    /// @param field The finite field (one of the kodoc_finite_field values)
+    explicit finite_field(int32_t field);
+
+    /// @return The finite field
+    int32_t field() const
+    {
+        return m_field;
+    }
+
+    /// @return The largest element of the field
+    uint8_t max_value() const;
+
+    /// @return The number of bytes needed to store the given number of
+    ///         elements
+    uint32_t elements_to_size(uint32_t elements) const;
+
+    /// @return The element at the given index of a packed vector
+    uint8_t get_value(const uint8_t* elements, uint32_t index) const;
+
+    /// Sets the element at the given index of a packed vector
+    void set_value(uint8_t* elements, uint32_t index, uint8_t value) const;
+
+    /// @return The product of two field elements
+    uint8_t multiply(uint8_t a, uint8_t b) const;
+
+    /// @return The multiplicative inverse of a non-zero field element
+    uint8_t invert(uint8_t a) const;
+
+    /// Computes dest[i] = dest[i] + constant * src[i] for a packed vector
+    /// @param size The size of both vectors in bytes
+    void region_multiply_add(uint8_t* dest, const uint8_t* src,
+                             uint8_t constant, uint32_t size) const;
+
+    /// Computes dest[i] = constant * dest[i] for a packed vector
+    /// @param size The size of the vector in bytes
+    void region_multiply(uint8_t* dest, uint8_t constant,
+                         uint32_t size) const;
+
+private:
+
+    int32_t m_field;
+};
+}
@@ -34,11 +34,50 @@
     #include <kodo_fulcrum/api/nested_symbol_size.hpp>
 #endif // !defined(KODOC_DISABLE_FULCRUM)
 
+#include "coder.hpp"
+#include "counters_binding.hpp"
+#include "factory_cache.hpp"
+#include "snapshot_binding.hpp"
+
 struct kodoc_factory { };
-struct kodoc_coder { };
 
 using namespace kodo_core::api;
 
+kodoc_coder::kodoc_coder(final_interface* the_api) :
+    api(the_api),
+    capabilities(0),
+    payload_size(dynamic_cast<payload_size_interface*>(the_api)),
+    read_payload(dynamic_cast<read_payload_interface*>(the_api)),
+    write_payload(dynamic_cast<write_payload_interface*>(the_api)),
+    rank(dynamic_cast<rank_interface*>(the_api)),
+    decoder(dynamic_cast<decoder_interface*>(the_api)),
+    partial_decoding(dynamic_cast<partial_decoding_interface*>(the_api)),
+    counters(dynamic_cast<kodoc::counters_interface*>(the_api)),
+    recycle(dynamic_cast<kodoc::recycle_interface*>(the_api)),
+    snapshot(dynamic_cast<kodoc::snapshot_interface*>(the_api))
+{
+    assert(api);
+
+    if (write_payload)
+        capabilities |= kodoc_capability_write_payload;
+    if (read_payload)
+        capabilities |= kodoc_capability_read_payload;
+    if (has_interface<feedback_size_interface>(api))
+        capabilities |= kodoc_capability_feedback_size;
+    if (partial_decoding)
+        capabilities |= kodoc_capability_partial_decoding;
+    if (has_interface<symbol_decoding_status_updater_interface>(api))
+        capabilities |= kodoc_capability_symbol_decoding_status_updater;
+    if (has_interface<systematic_interface>(api))
+        capabilities |= kodoc_capability_systematic;
+#if !defined(KODOC_DISABLE_TRACE)
+    if (has_interface<trace_interface>(api))
+        capabilities |= kodoc_capability_trace;
+#endif
+    if (snapshot)
+        capabilities |= kodoc_capability_snapshot;
+}
+
 //------------------------------------------------------------------
 // CONFIGURATION API
 //------------------------------------------------------------------
@@ -155,6 +194,7 @@ void kodoc_factory_set_symbols(kodoc_factory_t factory, uint32_t symbols)
 {
     auto api = (final_interface*) factory;
     assert(api);
+    kodoc::shared_factory_lock lock(factory);
     set_symbols(api, symbols);
 }
 
@@ -163,6 +203,7 @@ void kodoc_factory_set_symbol_size(
 {
     auto api = (final_interface*) factory;
     assert(api);
+    kodoc::shared_factory_lock lock(factory);
     set_symbol_size(api, symbol_size);
 }
 
@@ -170,14 +211,51 @@ kodoc_coder_t kodoc_factory_build_coder(kodoc_factory_t factory)
 {
     auto api = (final_interface*) factory;
     assert(api);
-    return (kodoc_coder_t) build(api)->keep_alive();
+    kodoc::shared_factory_lock lock(factory);
+    return new kodoc_coder(build(api)->keep_alive());
+}
+
+namespace kodoc
+{
+kodoc_coder_t build_coder(kodoc_factory_t factory, uint32_t symbols,
+                          uint32_t symbol_size, kodoc_coder_t idle)
+{
+    auto api = (final_interface*) factory;
+    assert(api);
+    shared_factory_lock lock(factory);
+
+    set_symbols(api, symbols);
+    set_symbol_size(api, symbol_size);
+
+    if (idle == nullptr)
+        return new kodoc_coder(build(api)->keep_alive());
+
+    assert(idle->recycle);
+    idle->recycle->recycle();
+    return idle;
+}
+
+void recycle_coder(kodoc_factory_t factory, kodoc_coder_t coder)
+{
+    assert(coder);
+    assert(coder->recycle);
+    shared_factory_lock lock(factory);
+    coder->recycle->recycle();
+}
 }
 
 void kodoc_delete_coder(kodoc_coder_t coder)
 {
-    auto api = (final_interface*) coder;
+    auto api = kodoc::coder_api(coder);
     assert(api);
     api->reset();
+    delete coder;
+}
+
+uint32_t kodoc_coder_capabilities(kodoc_coder_t coder)
+{
+    assert(coder);
+    return coder->capabilities;
 }
 
 //------------------------------------------------------------------
@@ -186,30 +264,76 @@ void kodoc_delete_coder(kodoc_coder_t coder)
 
 uint32_t kodoc_payload_size(kodoc_coder_t coder)
 {
-    auto api = (final_interface*) coder;
-    assert(api);
-    return payload_size(api);
+    assert(coder);
+    assert(coder->payload_size);
+    return coder->payload_size->payload_size();
 }
 
 void kodoc_read_payload(kodoc_coder_t decoder, uint8_t* payload)
 {
-    auto api = (final_interface*) decoder;
-    assert(api);
-    read_payload(api, payload);
+    assert(decoder);
+    assert(decoder->read_payload);
+    decoder->read_payload->read_payload(payload);
+}
+
+uint32_t kodoc_read_payloads(kodoc_coder_t decoder, uint8_t** payloads,
+                             uint32_t count)
+{
+    assert(decoder);
+    assert(payloads);
+
+    auto read_api = decoder->read_payload;
+    auto decoder_api = decoder->decoder;
+    assert(read_api);
+    assert(decoder_api);
+
+    uint32_t used = 0;
+    while (used < count && !decoder_api->is_complete())
+    {
+        read_api->read_payload(payloads[used]);
+        ++used;
+    }
+
+    return used;
 }
 
 uint32_t kodoc_write_payload(kodoc_coder_t coder, uint8_t* payload)
 {
-    auto api = (final_interface*) coder;
-    assert(api);
-    return write_payload(api, payload);
+    assert(coder);
+    assert(coder->write_payload);
+    return coder->write_payload->write_payload(payload);
+}
+
+uint64_t kodoc_write_payloads(kodoc_coder_t coder, uint8_t* buffer,
+                              uint32_t stride, uint32_t count,
+                              uint32_t* bytes_used)
+{
+    assert(coder);
+    assert(buffer);
+    assert(stride >= kodoc_payload_size(coder));
+
+    auto write_api = coder->write_payload;
+    assert(write_api);
+
+    uint64_t total_bytes = 0;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        // The offset and the total are not computed in 32 bits, since
+        // count * stride may exceed 32 bits for a large buffer
+        uint32_t used = write_api->write_payload(buffer + (size_t) i * stride);
+        total_bytes += used;
+
+        if (bytes_used != nullptr)
+            bytes_used[i] = used;
+    }
+
+    return total_bytes;
 }
 
 uint8_t kodoc_has_write_payload(kodoc_coder_t coder)
 {
-    auto api = (final_interface*) coder;
-    assert(api);
-    return has_interface<write_payload_interface>(api);
+    assert(coder);
+    return (coder->capabilities & kodoc_capability_write_payload) != 0;
 }
 
 //------------------------------------------------------------------
@@ -218,14 +342,14 @@ uint8_t kodoc_has_write_payload(kodoc_coder_t coder)
 
 uint32_t kodoc_block_size(kodoc_coder_t coder)
 {
-    auto api = (final_interface*) coder;
+    auto api = kodoc::coder_api(coder);
     assert(api);
     return block_size(api);
 }
 
 void kodoc_set_const_symbols(kodoc_coder_t coder, uint8_t* data, uint32_t size)
 {
-    auto api = (final_interface*) coder;
+    auto api = kodoc::coder_api(coder);
     assert(api);
     set_const_symbols(api, storage::storage(data, size));
 }
@@ -233,7 +357,7 @@ void kodoc_set_const_symbols(kodoc_coder_t coder, uint8_t* data, uint32_t size)
 void kodoc_set_const_symbol(
     kodoc_coder_t coder, uint32_t index, uint8_t* data, uint32_t size)
 {
-    auto api = (final_interface*) coder;
+    auto api = kodoc::coder_api(coder);
     assert(api);
     set_const_symbol(api, index, storage::storage(data, size));
 }
@@ -241,7 +365,7 @@ void kodoc_set_const_symbol(
 void kodoc_set_mutable_symbols(
     kodoc_coder_t coder, uint8_t* data, uint32_t size)
 {
-    auto api = (final_interface*) coder;
+    auto api = kodoc::coder_api(coder);
     assert(api);
     set_mutable_symbols(api, storage::storage(data, size));
 }
@@ -249,28 +373,28 @@ void kodoc_set_mutable_symbols(
 void kodoc_set_mutable_symbol(
     kodoc_coder_t coder, uint32_t index, uint8_t* data, uint32_t size)
 {
-    auto api = (final_interface*) coder;
+    auto api = kodoc::coder_api(coder);
     assert(api);
     set_mutable_symbol(api, index, storage::storage(data, size));
 }
 
 uint32_t kodoc_symbol_size(kodoc_coder_t coder)
 {
-    auto api = (final_interface*) coder;
+    auto api = kodoc::coder_api(coder);
     assert(api);
     return symbol_size(api);
 }
 
 uint32_t kodoc_symbols(kodoc_coder_t coder)
 {
-    auto api = (final_interface*) coder;
+    auto api = kodoc::coder_api(coder);
     assert(api);
     return symbols(api);
 }
 
 uint32_t kodoc_coefficient_vector_size(kodoc_coder_t coder)
 {
-    auto api = (final_interface*) coder;
+    auto api = kodoc::coder_api(coder);
     assert(api);
     return coefficient_vector_size(api);
 }
@@ -281,126 +405,125 @@ uint32_t kodoc_coefficient_vector_size(kodoc_coder_t coder)
 
 uint8_t kodoc_is_complete(kodoc_coder_t decoder)
 {
-    auto api = (final_interface*) decoder;
-    assert(api);
-    return is_complete(api);
+    assert(decoder);
+    assert(decoder->decoder);
+    return decoder->decoder->is_complete();
 }
 
 uint8_t kodoc_is_partially_complete(kodoc_coder_t decoder)
 {
-    auto api = (final_interface*) decoder;
-    assert(api);
-    return is_partially_complete(api);
+    assert(decoder);
+    assert(decoder->partial_decoding);
+    return decoder->partial_decoding->is_partially_complete();
 }
 
 uint8_t kodoc_has_feedback_size(kodoc_coder_t coder)
 {
-    auto api = (final_interface*) coder;
-    assert(api);
-    return has_interface<feedback_size_interface>(api);
+    assert(coder);
+    return (coder->capabilities & kodoc_capability_feedback_size) != 0;
 }
 
 uint8_t kodoc_feedback_size(kodoc_coder_t coder)
 {
-    auto api = (final_interface*) coder;
+    auto api = kodoc::coder_api(coder);
     assert(api);
     return feedback_size(api);
 }
 
 void kodoc_read_feedback(kodoc_coder_t encoder, uint8_t* feedback)
 {
-    auto api = (final_interface*) encoder;
+    auto api = kodoc::coder_api(encoder);
     assert(api);
     read_feedback(api, feedback);
 }
 
 uint32_t kodoc_write_feedback(kodoc_coder_t decoder, uint8_t* feedback)
 {
-    auto api = (final_interface*) decoder;
+    auto api = kodoc::coder_api(decoder);
     assert(api);
     return write_feedback(api, feedback);
 }
 
 uint32_t kodoc_rank(kodoc_coder_t coder)
 {
-    auto api = (final_interface*) coder;
-    assert(api);
-    return rank(api);
+    assert(coder);
+    assert(coder->rank);
+    return coder->rank->rank();
 }
 
 uint8_t kodoc_is_symbol_pivot(kodoc_coder_t decoder, uint32_t index)
 {
-    auto api = (final_interface*) decoder;
-    assert(api);
-    return is_symbol_pivot(api, index);
+    assert(decoder);
+    assert(decoder->decoder);
+    return decoder->decoder->is_symbol_pivot(index);
 }
 
 uint8_t kodoc_is_symbol_missing(kodoc_coder_t decoder, uint32_t index)
 {
-    auto api = (final_interface*) decoder;
+    auto api = kodoc::coder_api(decoder);
     assert(api);
     return is_symbol_missing(api, index);
 }
 
 uint8_t kodoc_is_symbol_partially_decoded(kodoc_coder_t decoder, uint32_t index)
 {
-    auto api = (final_interface*) decoder;
+    auto api = kodoc::coder_api(decoder);
     assert(api);
     return is_symbol_partially_decoded(api, index);
 }
 
 uint8_t kodoc_is_symbol_uncoded(kodoc_coder_t decoder, uint32_t index)
 {
-    auto api = (final_interface*) decoder;
-    assert(api);
-    return is_symbol_uncoded(api, index);
+    assert(decoder);
+    assert(decoder->decoder);
+    return decoder->decoder->is_symbol_uncoded(index);
 }
 
 uint32_t kodoc_symbols_missing(kodoc_coder_t decoder)
 {
-    auto api = (final_interface*) decoder;
+    auto api = kodoc::coder_api(decoder);
     assert(api);
     return symbols_missing(api);
 }
 
 uint32_t kodoc_symbols_partially_decoded(kodoc_coder_t decoder)
 {
-    auto api = (final_interface*) decoder;
+    auto api = kodoc::coder_api(decoder);
     assert(api);
     return symbols_partially_decoded(api);
 }
 
 uint32_t kodoc_symbols_uncoded(kodoc_coder_t decoder)
 {
-    auto api = (final_interface*) decoder;
-    assert(api);
-    return symbols_uncoded(api);
+    assert(decoder);
+    assert(decoder->decoder);
+    return decoder->decoder->symbols_uncoded();
 }
 
 void kodoc_set_status_updater_on(kodoc_coder_t decoder)
 {
-    auto api = (final_interface*) decoder;
+    auto api = kodoc::coder_api(decoder);
     assert(api);
     set_status_updater_on(api);
 }
 
 void kodoc_set_status_updater_off(kodoc_coder_t decoder)
 {
-    auto api = (final_interface*) decoder;
+    auto api = kodoc::coder_api(decoder);
     assert(api);
     set_status_updater_off(api);
 }
 
 void kodoc_update_symbol_status(kodoc_coder_t decoder)
 {
-    auto api = (final_interface*) decoder;
+    auto api = kodoc::coder_api(decoder);
     assert(api);
     update_symbol_status(api);
 }
 
 uint8_t kodoc_is_status_updater_enabled(kodoc_coder_t decoder)
 {
-    auto api = (final_interface*) decoder;
+    auto api = kodoc::coder_api(decoder);
     assert(api);
     return is_status_updater_enabled(api);
 }
@@ -408,7 +531,7 @@ uint8_t kodoc_is_status_updater_enabled(kodoc_coder_t decoder)
 void kodoc_read_symbol(kodoc_coder_t decoder, uint8_t* symbol_data,
                        uint8_t* coefficients)
 {
-    auto api = (final_interface*) decoder;
+    auto api = kodoc::coder_api(decoder);
     assert(api);
     return read_symbol(api, symbol_data, coefficients);
 }
@@ -416,7 +539,7 @@ void kodoc_read_symbol(kodoc_coder_t decoder, uint8_t* symbol_data,
 void kodoc_read_uncoded_symbol(
     kodoc_coder_t decoder, uint8_t* symbol_data, uint32_t index)
 {
-    auto api = (final_interface*) decoder;
+    auto api = kodoc::coder_api(decoder);
     assert(api);
     return read_uncoded_symbol(api, symbol_data, index);
 }
@@ -424,7 +547,7 @@ void kodoc_read_uncoded_symbol(
 uint32_t kodoc_write_symbol(
     kodoc_coder_t encoder, uint8_t* symbol_data, uint8_t* coefficients)
 {
-    auto api = (final_interface*) encoder;
+    auto api = kodoc::coder_api(encoder);
     assert(api);
     return write_symbol(api, symbol_data, coefficients);
 }
@@ -432,7 +555,7 @@ uint32_t kodoc_write_symbol(
 uint32_t kodoc_write_uncoded_symbol(
     kodoc_coder_t encoder, uint8_t* symbol_data, uint32_t index)
 {
-    auto api = (final_interface*) encoder;
+    auto api = kodoc::coder_api(encoder);
     assert(api);
     return write_uncoded_symbol(api, symbol_data, index);
 }
@@ -444,42 +567,40 @@ uint32_t kodoc_write_uncoded_symbol(
 uint8_t kodoc_has_symbol_decoding_status_updater_interface(
     kodoc_coder_t decoder)
 {
-    auto api = (final_interface*) decoder;
-    assert(api);
-    return has_interface<symbol_decoding_status_updater_interface>(api);
+    assert(decoder);
+    return (decoder->capabilities &
+            kodoc_capability_symbol_decoding_status_updater) != 0;
 }
 
 uint8_t kodoc_has_partial_decoding_interface(kodoc_coder_t decoder)
 {
-    auto api = (final_interface*) decoder;
-    assert(api);
-    return has_interface<partial_decoding_interface>(api);
+    assert(decoder);
+    return (decoder->capabilities & kodoc_capability_partial_decoding) != 0;
 }
 
 uint8_t kodoc_has_systematic_interface(kodoc_coder_t encoder)
 {
-    auto api = (final_interface*) encoder;
-    assert(api);
-    return has_interface<systematic_interface>(api);
+    assert(encoder);
+    return (encoder->capabilities & kodoc_capability_systematic) != 0;
 }
 
 uint8_t kodoc_is_systematic_on(kodoc_coder_t encoder)
 {
-    auto api = (final_interface*) encoder;
+    auto api = kodoc::coder_api(encoder);
     assert(api);
     return is_systematic_on(api);
 }
 
 void kodoc_set_systematic_on(kodoc_coder_t encoder)
 {
-    auto api = (final_interface*) encoder;
+    auto api = kodoc::coder_api(encoder);
     assert(api);
     set_systematic_on(api);
 }
 
 void kodoc_set_systematic_off(kodoc_coder_t encoder)
 {
-    auto api = (final_interface*) encoder;
+    auto api = kodoc::coder_api(encoder);
     assert(api);
     set_systematic_off(api);
 }
@@ -490,44 +611,119 @@ void kodoc_set_systematic_off(kodoc_coder_t encoder)
 
 uint8_t kodoc_has_trace_interface(kodoc_coder_t coder)
 {
-    auto api = (final_interface*) coder;
-    assert(api);
-    return has_interface<trace_interface>(api);
+    assert(coder);
+    return (coder->capabilities & kodoc_capability_trace) != 0;
 }
 
 void kodoc_set_trace_callback(
     kodoc_coder_t coder, kodoc_trace_callback_t c_callback, void* context)
 {
     assert(c_callback);
-    auto api = (final_interface*) coder;
+    auto api = kodoc::coder_api(coder);
     assert(api);
+#if !defined(KODOC_DISABLE_TRACE)
     auto callback = [c_callback, context](const std::string& zone,
                                           const std::string& data)
     {
         c_callback(zone.c_str(), data.c_str(), context);
     };
     set_trace_callback(api, callback);
+#else
+    (void)api;
+    (void)context;
+#endif
 }
 
 void kodoc_set_trace_stdout(kodoc_coder_t coder)
 {
-    auto api = (final_interface*) coder;
+    auto api = kodoc::coder_api(coder);
     assert(api);
+#if !defined(KODOC_DISABLE_TRACE)
     set_trace_stdout(api);
+#else
+    (void)api;
+#endif
 }
 
 void kodoc_set_trace_off(kodoc_coder_t coder)
 {
-    auto api = (final_interface*) coder;
+    auto api = kodoc::coder_api(coder);
     assert(api);
+#if !defined(KODOC_DISABLE_TRACE)
     set_trace_off(api);
+#else
+    (void)api;
+#endif
 }
 
 void kodoc_set_zone_prefix(kodoc_coder_t coder, const char* prefix)
 {
-    auto api = (final_interface*) coder;
+    auto api = kodoc::coder_api(coder);
     assert(api);
+#if !defined(KODOC_DISABLE_TRACE)
     set_zone_prefix(api, std::string(prefix));
+#else
+    (void)api;
+    (void)prefix;
+#endif
+}
+
+//------------------------------------------------------------------
+// COUNTERS API
+//------------------------------------------------------------------
+
+void kodoc_get_counters(kodoc_coder_t coder, kodoc_counters_t* counters)
+{
+    assert(coder);
+    assert(coder->counters);
+    assert(counters);
+
+    *counters = coder->counters->counters();
+}
+
+void kodoc_reset_counters(kodoc_coder_t coder)
+{
+    assert(coder);
+    assert(coder->counters);
+
+    coder->counters->reset_counters();
+}
+
+//------------------------------------------------------------------
+// DECODER SNAPSHOT API
+//------------------------------------------------------------------
+
+uint8_t kodoc_has_snapshot_interface(kodoc_coder_t decoder)
+{
+    assert(decoder);
+    return (decoder->capabilities & kodoc_capability_snapshot) != 0;
+}
+
+uint32_t kodoc_decoder_snapshot_size(kodoc_coder_t decoder)
+{
+    assert(decoder);
+    assert(decoder->snapshot);
+
+    return decoder->snapshot->snapshot_size();
+}
+
+uint32_t kodoc_decoder_snapshot(kodoc_coder_t decoder, uint8_t* buffer)
+{
+    assert(decoder);
+    assert(decoder->snapshot);
+    assert(buffer);
+
+    return decoder->snapshot->snapshot(buffer);
+}
+
+uint8_t kodoc_decoder_restore(kodoc_coder_t decoder, const uint8_t* buffer,
+                              uint32_t size)
+{
+    assert(decoder);
+    assert(decoder->snapshot);
+    assert(buffer);
+
+    return decoder->snapshot->restore(buffer, size);
 }
 
 //------------------------------------------------------------------
@@ -536,14 +732,14 @@ void kodoc_set_zone_prefix(kodoc_coder_t coder, const char* prefix)
 
 double kodoc_density(kodoc_coder_t encoder)
 {
-    auto api = (final_interface*) encoder;
+    auto api = kodoc::coder_api(encoder);
     assert(api);
     return density(api);
 }
 
 void kodoc_set_density(kodoc_coder_t encoder, double density)
 {
-    auto api = (final_interface*) encoder;
+    auto api = kodoc::coder_api(encoder);
     assert(api);
     set_density(api, density);
 }
@@ -555,7 +751,7 @@ void kodoc_set_density(kodoc_coder_t encoder, double density)
 uint8_t kodoc_pseudo_systematic(kodoc_coder_t encoder)
 {
 #if !defined(KODOC_DISABLE_RLNC)
-    auto api = (final_interface*) encoder;
+    auto api = kodoc::coder_api(encoder);
     assert(api);
     return kodo_rlnc::api::pseudo_systematic(api);
 #else
@@ -568,7 +764,7 @@ void kodoc_set_pseudo_systematic(
     kodoc_coder_t encoder, uint8_t pseudo_systematic)
 {
 #if !defined(KODOC_DISABLE_RLNC)
-    auto api = (final_interface*) encoder;
+    auto api = kodoc::coder_api(encoder);
     assert(api);
     kodo_rlnc::api::set_pseudo_systematic(api, pseudo_systematic != 0);
 #else
@@ -580,7 +776,7 @@ void kodoc_set_pseudo_systematic(
 uint8_t kodoc_pre_charging(kodoc_coder_t encoder)
 {
 #if !defined(KODOC_DISABLE_RLNC)
-    auto api = (final_interface*) encoder;
+    auto api = kodoc::coder_api(encoder);
     assert(api);
     return kodo_rlnc::api::pre_charging(api);
 #else
@@ -592,7 +788,7 @@ uint8_t kodoc_pre_charging(kodoc_coder_t encoder)
 void kodoc_set_pre_charging(kodoc_coder_t encoder, uint8_t pre_charging)
 {
 #if !defined(KODOC_DISABLE_RLNC)
-    auto api = (final_interface*) encoder;
+    auto api = kodoc::coder_api(encoder);
     assert(api);
     kodo_rlnc::api::set_pre_charging(api, pre_charging != 0);
 #else
@@ -604,7 +800,7 @@ void kodoc_set_pre_charging(kodoc_coder_t encoder, uint8_t pre_charging)
 uint32_t kodoc_width(kodoc_coder_t encoder)
 {
 #if !defined(KODOC_DISABLE_RLNC)
-    auto api = (final_interface*) encoder;
+    auto api = kodoc::coder_api(encoder);
     assert(api);
     return kodo_rlnc::api::width(api);
 #else
@@ -616,7 +812,7 @@ uint32_t kodoc_width(kodoc_coder_t encoder)
 void kodoc_set_width(kodoc_coder_t encoder, uint32_t width)
 {
 #if !defined(KODOC_DISABLE_RLNC)
-    auto api = (final_interface*) encoder;
+    auto api = kodoc::coder_api(encoder);
     assert(api);
     kodo_rlnc::api::set_width(api, width);
 #else
@@ -628,7 +824,7 @@ void kodoc_set_width(kodoc_coder_t encoder, uint32_t width)
 double kodoc_width_ratio(kodoc_coder_t encoder)
 {
 #if !defined(KODOC_DISABLE_RLNC)
-    auto api = (final_interface*) encoder;
+    auto api = kodoc::coder_api(encoder);
     assert(api);
     return kodo_rlnc::api::width_ratio(api);
 #else
@@ -640,7 +836,7 @@ double kodoc_width_ratio(kodoc_coder_t encoder)
 void kodoc_set_width_ratio(kodoc_coder_t encoder, double width_ratio)
 {
 #if !defined(KODOC_DISABLE_RLNC)
-    auto api = (final_interface*) encoder;
+    auto api = kodoc::coder_api(encoder);
     assert(api);
     kodo_rlnc::api::set_width_ratio(api, width_ratio);
 #else
@@ -656,7 +852,7 @@ void kodoc_set_width_ratio(kodoc_coder_t encoder, double width_ratio)
 uint32_t kodoc_expansion(kodoc_coder_t coder)
 {
 #if !defined(KODOC_DISABLE_FULCRUM)
-    auto api = (final_interface*) coder;
+    auto api = kodoc::coder_api(coder);
     assert(api);
     return kodo_fulcrum::api::expansion(api);
 #else
@@ -668,7 +864,7 @@ uint32_t kodoc_expansion(kodoc_coder_t coder)
 uint32_t kodoc_inner_symbols(kodoc_coder_t coder)
 {
 #if !defined(KODOC_DISABLE_FULCRUM)
-    auto api = (final_interface*) coder;
+    auto api = kodoc::coder_api(coder);
     assert(api);
     return kodo_fulcrum::api::inner_symbols(api);
 #else
@@ -683,7 +879,7 @@ uint32_t kodoc_inner_symbols(kodoc_coder_t coder)
 uint32_t kodoc_nested_symbols(kodoc_coder_t encoder)
 {
 #if !defined(KODOC_DISABLE_FULCRUM)
-    auto api = (final_interface*) encoder;
+    auto api = kodoc::coder_api(encoder);
     assert(api);
     return kodo_fulcrum::api::nested_symbols(api);
 #else
@@ -695,7 +891,7 @@ uint32_t kodoc_nested_symbols(kodoc_coder_t encoder)
 uint32_t kodoc_nested_symbol_size(kodoc_coder_t encoder)
 {
 #if !defined(KODOC_DISABLE_FULCRUM)
-    auto api = (final_interface*) encoder;
+    auto api = kodoc::coder_api(encoder);
     assert(api);
     return kodo_fulcrum::api::nested_symbol_size(api);
 #else
@@ -725,6 +921,7 @@ void kodoc_factory_set_expansion(kodoc_factory_t factory, uint32_t expansion)
 #if !defined(KODOC_DISABLE_FULCRUM)
     auto api = (final_interface*) factory;
     assert(api);
+    kodoc::shared_factory_lock lock(factory);
     kodo_fulcrum::api::set_expansion(api, expansion);
 #else
     (void)factory;
@@ -37,6 +37,11 @@ extern "C" {
 /// Callback function type used for tracing
 typedef void (*kodoc_trace_callback_t)(const char*, const char*, void*);
 
+/// Callback function type used to report completed blocks. The arguments
+/// are the block index, the decoded block data, the number of object bytes
+/// in the block and the user context.
+typedef void (*kodoc_block_callback_t)(uint32_t, uint8_t*, uint32_t, void*);
+
 //------------------------------------------------------------------
 // KODO-C TYPES
 //------------------------------------------------------------------
@@ -47,6 +52,143 @@ typedef struct kodoc_factory* kodoc_factory_t;
 /// Opaque pointer used for encoders and decoders
 typedef struct kodoc_coder* kodoc_coder_t;
 
+/// Opaque pointer used for coder pools
+typedef struct kodoc_coder_pool* kodoc_coder_pool_t;
+
+/// Opaque pointer used for object encoders
+typedef struct kodoc_object_encoder* kodoc_object_encoder_t;
+
+/// Opaque pointer used for object decoders
+typedef struct kodoc_object_decoder* kodoc_object_decoder_t;
+
+/// Opaque pointer used for parallel encoders
+typedef struct kodoc_parallel_encoder* kodoc_parallel_encoder_t;
+
+/// Opaque pointer used for parallel decoders
+typedef struct kodoc_parallel_decoder* kodoc_parallel_decoder_t;
+
+/// Opaque pointer used for prefill encoders
+typedef struct kodoc_prefill_encoder* kodoc_prefill_encoder_t;
+
+/// Opaque pointer used for relays
+typedef struct kodoc_relay* kodoc_relay_t;
+
+/// Opaque pointer used for batch encoders
+typedef struct kodoc_batch_encoder* kodoc_batch_encoder_t;
+
+/// A buffer in a scatter/gather list. The layout differs from a struct
+/// iovec (the size is 32 bits, while iov_len is a size_t), so the fields
+/// must be copied to iov_base and iov_len one by one, see the
+/// udp_batch_sender example. A kodoc_iovec_t array cannot be cast to a
+/// struct iovec array.
+typedef struct
+{
+    const uint8_t* data;
+    uint32_t size;
+} kodoc_iovec_t;
+
+/// Counters of an encoder or decoder, see kodoc_get_counters()
+typedef struct
+{
+    /// The number of payloads written by an encoder
+    uint64_t payloads_written;
+
+    /// The number of payloads read by a decoder
+    uint64_t payloads_read;
+
+    /// The number of payloads read by a decoder that did not increase the
+    /// rank of the decoder
+    uint64_t linearly_dependent;
+
+    /// The number of payloads written by an encoder that contained a
+    /// systematic (uncoded) symbol
+    uint64_t systematic_sent;
+
+    /// The number of payloads written by an encoder that contained a
+    /// coded symbol
+    uint64_t coded_sent;
+
+    /// The total time spent in writing payloads in nanoseconds
+    uint64_t encode_nanoseconds;
+
+    /// The total time spent in reading payloads in nanoseconds
+    uint64_t decode_nanoseconds;
+} kodoc_counters_t;
+
+/// Opaque pointer used for event rings
+typedef struct kodoc_event_ring* kodoc_event_ring_t;
+
+/// The symbol index of an event that does not refer to a single symbol
+#define KODOC_NO_SYMBOL 0xFFFFFFFFU
+
+/// Enum specifying the types of trace events
+/// Note: the size of the enum type cannot be guaranteed, so the uint32_t
+/// type is used in kodoc_event_t to store the enum values
+typedef enum
+{
+    /// An encoder wrote a payload. The symbol is the index of the source
+    /// symbol for a systematic payload, otherwise KODOC_NO_SYMBOL.
+    kodoc_event_payload_written,
+
+    /// A decoder read a payload that increased its rank
+    kodoc_event_payload_read,
+
+    /// A decoder read a payload that did not increase its rank
+    kodoc_event_dependent_payload_read,
+
+    /// A decoder read the uncoded symbol with the given symbol index
+    kodoc_event_uncoded_symbol_read,
+
+    /// A decoder reached full rank
+    kodoc_event_decoding_complete
+}
+kodoc_event_type;
+
+/// A fixed-size trace event, see kodoc_set_event_ring()
+typedef struct
+{
+    /// The time of the event in nanoseconds on a monotonic clock
+    uint64_t timestamp;
+
+    /// The event type (one of the kodoc_event_type values)
+    uint32_t type;
+
+    /// The symbol index, or KODOC_NO_SYMBOL
+    uint32_t symbol;
+
+    /// The rank of the coder after the operation
+    uint32_t rank;
+
+    /// The bytes used in the written payload, or 0 for decoder events
+    uint32_t bytes;
+} kodoc_event_t;
+
+/// Callback function type used to allocate memory. The arguments are the
+/// size in bytes and the user context. The returned buffer must be aligned
+/// for any type, or NULL if the memory is exhausted.
+typedef void* (*kodoc_alloc_callback_t)(uint64_t, void*);
+
+/// Callback function type used to free memory. The arguments are the
+/// buffer, its size in bytes and the user context.
+typedef void (*kodoc_free_callback_t)(void*, uint64_t, void*);
+
+/// A memory allocator, see kodoc_new_encoder_factory_with_allocator()
+typedef struct
+{
+    kodoc_alloc_callback_t alloc;
+    kodoc_free_callback_t free;
+    void* context;
+} kodoc_allocator_t;
+
+/// Opaque pointer used for arenas
+typedef struct kodoc_arena* kodoc_arena_t;
+
+/// Opaque pointer used for file encoders
+typedef struct kodoc_file_encoder* kodoc_file_encoder_t;
+
+/// Opaque pointer used for file decoders
+typedef struct kodoc_file_decoder* kodoc_file_decoder_t;
+
 /// Enum specifying the available finite fields
 /// Note: the size of the enum type cannot be guaranteed, so the int32_t type
 /// is used in the API calls to pass the enum values
@@ -76,6 +218,21 @@ typedef enum
 }
 kodoc_codec;
 
+/// Flags for the optional features of an encoder or decoder, see
+/// kodoc_coder_capabilities()
+typedef enum
+{
+    kodoc_capability_write_payload = 1 << 0,
+    kodoc_capability_read_payload = 1 << 1,
+    kodoc_capability_feedback_size = 1 << 2,
+    kodoc_capability_partial_decoding = 1 << 3,
+    kodoc_capability_symbol_decoding_status_updater = 1 << 4,
+    kodoc_capability_systematic = 1 << 5,
+    kodoc_capability_trace = 1 << 6,
+    kodoc_capability_snapshot = 1 << 7
+}
+kodoc_capability;
+
 //------------------------------------------------------------------
 // CONFIGURATION API
 //------------------------------------------------------------------
@@ -181,6 +338,203 @@ kodoc_coder_t kodoc_factory_build_coder(kodoc_factory_t factory);
 KODOC_API
 void kodoc_delete_coder(kodoc_coder_t coder);
 
+/// Returns the optional features of an encoder or decoder. The features
+/// are determined once when the coder is built, so this is a cheap call
+/// that can be made for every packet. The kodoc_has_*() functions are
+/// answered from the same flags.
+/// @param coder The encoder/decoder to query
+/// @return A combination of kodoc_capability flags
+KODOC_API
+uint32_t kodoc_coder_capabilities(kodoc_coder_t coder);
+
+//------------------------------------------------------------------
+// ALLOCATOR API
+//------------------------------------------------------------------
+
+/// Builds a new encoder factory in the same way as
+/// kodoc_new_encoder_factory(), and attaches an allocator to it.
+/// The allocator provides the buffers that kodo-c allocates for the object
+/// encoders, parallel encoders and file encoders that are built with the
+/// factory (e.g. the payload rings and the padded last block).
+/// Note: the factory itself and the internal state of its coders (such as
+/// the coefficient storage) are still allocated on the global heap by the
+/// coding library. Reuse coders with a coder pool to avoid allocating this
+/// memory for every block.
+/// The objects that are not built from a factory do not use an allocator:
+/// the relay and the batch encoder allocate all their memory on the global
+/// heap.
+/// @param codec This parameter determines the encoding algorithms used.
+/// @param finite_field The finite field that should be used by the encoder.
+/// @param max_symbols The maximum number of symbols supported by encoders
+///        built with this factory.
+/// @param max_symbol_size The maximum symbol size in bytes supported by
+///        encoders built using the returned factory
+/// @param allocator The allocator, which is copied. The allocator context
+///        must remain valid until all objects that use it are deleted.
+/// @return A new factory capable of building encoders using the
+///         selected parameters.
+KODOC_API
+kodoc_factory_t kodoc_new_encoder_factory_with_allocator(
+    int32_t codec, int32_t finite_field, uint32_t max_symbols,
+    uint32_t max_symbol_size, const kodoc_allocator_t* allocator);
+
+/// Builds a new decoder factory in the same way as
+/// kodoc_new_decoder_factory(), and attaches an allocator to it.
+/// The allocator provides the buffers that kodo-c allocates for the object
+/// decoders, parallel decoders and file decoders that are built with the
+/// factory. The same limits apply as for
+/// kodoc_new_encoder_factory_with_allocator().
+/// @param codec This parameter determines the decoding algorithms used.
+/// @param finite_field The finite field that should be used by the decoder.
+/// @param max_symbols The maximum number of symbols supported by decoders
+///        built with this factory.
+/// @param max_symbol_size The maximum symbol size in bytes supported by
+///        decoders built using the returned factory
+/// @param allocator The allocator, which is copied. The allocator context
+///        must remain valid until all objects that use it are deleted.
+/// @return A new factory capable of building decoders using the
+///         selected parameters.
+KODOC_API
+kodoc_factory_t kodoc_new_decoder_factory_with_allocator(
+    int32_t codec, int32_t finite_field, uint32_t max_symbols,
+    uint32_t max_symbol_size, const kodoc_allocator_t* allocator);
+
+/// Builds a new arena, which hands out memory from large chunks taken from
+/// the heap. Freeing a single buffer has no effect, all memory of the
+/// arena is released at once when the arena is deleted. An arena is not
+/// synchronized, so it must only be used by one thread at a time, e.g. one
+/// arena per thread or per tenant.
+/// @param chunk_size The size of the chunks taken from the heap in bytes.
+///        Larger allocations get a chunk of their own.
+/// @return A new arena
+KODOC_API
+kodoc_arena_t kodoc_new_arena(uint64_t chunk_size);
+
+/// Releases all memory of an arena. All objects that were built with the
+/// allocator of the arena must be deleted before the arena.
+/// @param arena The arena which should be deallocated
+KODOC_API
+void kodoc_delete_arena(kodoc_arena_t arena);
+
+/// Returns an allocator that allocates from the arena
+/// @param arena The arena to use
+/// @return The allocator of the arena
+KODOC_API
+kodoc_allocator_t kodoc_arena_allocator(kodoc_arena_t arena);
+
+/// Returns the memory that the arena has taken from the heap
+/// @param arena The arena to query
+/// @return The size of all chunks in bytes
+KODOC_API
+uint64_t kodoc_arena_reserved(kodoc_arena_t arena);
+
+/// Returns the memory that has been allocated from the arena
+/// @param arena The arena to query
+/// @return The size of all allocations in bytes
+KODOC_API
+uint64_t kodoc_arena_used(kodoc_arena_t arena);
+
+//------------------------------------------------------------------
+// FACTORY CACHE API
+//------------------------------------------------------------------
+
+/// Returns a shared encoder factory from a process-wide cache. The first
+/// call with a given set of parameters builds the factory, and subsequent
+/// calls with the same parameters return the same factory. The cache is
+/// thread-safe and every factory is reference counted. The calls that
+/// build coders from a shared factory or change its parameters, such as
+/// kodoc_factory_build_coder() and kodoc_factory_set_symbols(), are
+/// serialized, so a shared factory can be used from several threads.
+/// Note: the factory is shared by everyone who acquired it, so changing the
+/// number of symbols or the symbol size on it affects all users, and a
+/// change followed by kodoc_factory_build_coder() is not atomic. The
+/// object encoders and decoders set up the factory and build (or recycle)
+/// each block coder in a single serialized step, so they can share a
+/// factory safely. Use kodoc_new_encoder_factory() to get a factory that
+/// is not shared.
+/// @param codec This parameter determines the encoding algorithms used.
+/// @param finite_field The finite field that should be used by the encoder.
+/// @param max_symbols The maximum number of symbols supported by encoders
+///        built with this factory.
+/// @param max_symbol_size The maximum symbol size in bytes supported by
+///        encoders built using the returned factory
+/// @return The shared factory. It must be released with
+///         kodoc_release_factory() and not with kodoc_delete_factory().
+KODOC_API
+kodoc_factory_t kodoc_acquire_encoder_factory(
+    int32_t codec, int32_t finite_field,
+    uint32_t max_symbols, uint32_t max_symbol_size);
+
+/// Returns a shared decoder factory from a process-wide cache. See
+/// kodoc_acquire_encoder_factory() for how the factories are shared.
+/// @param codec This parameter determines the decoding algorithms used.
+/// @param finite_field The finite field that should be used by the decoder.
+/// @param max_symbols The maximum number of symbols supported by decoders
+///        built with this factory.
+/// @param max_symbol_size The maximum symbol size in bytes supported by
+///        decoders built using the returned factory
+/// @return The shared factory. It must be released with
+///         kodoc_release_factory() and not with kodoc_delete_factory().
+KODOC_API
+kodoc_factory_t kodoc_acquire_decoder_factory(
+    int32_t codec, int32_t finite_field,
+    uint32_t max_symbols, uint32_t max_symbol_size);
+
+/// Releases a factory returned by kodoc_acquire_encoder_factory() or
+/// kodoc_acquire_decoder_factory(). The factory is deallocated when the
+/// last reference is released.
+/// @param factory The factory which should be released
+KODOC_API
+void kodoc_release_factory(kodoc_factory_t factory);
+
+//------------------------------------------------------------------
+// CODER POOL API
+//------------------------------------------------------------------
+
+/// Builds a new coder pool for the given factory. A pool keeps coders that
+/// are no longer used and hands them out again instead of building new
+/// ones. A recycled coder is reset to the state of a newly built coder,
+/// but the memory allocated for its coding state (e.g. the decoding matrix
+/// and the coefficient storage) is reused. This makes the setup of a coder
+/// much cheaper when many small blocks are coded in a sequence.
+/// The pool is not thread-safe.
+/// @param factory The factory that is used to build new coders. The factory
+///        must not be deleted before the pool.
+/// @return A new, empty coder pool
+KODOC_API
+kodoc_coder_pool_t kodoc_new_coder_pool(kodoc_factory_t factory);
+
+/// Deletes all idle coders in the pool and releases the pool itself.
+/// Coders that are acquired and not released must be deleted with
+/// kodoc_delete_coder().
+/// @param pool The pool which should be deallocated
+KODOC_API
+void kodoc_delete_coder_pool(kodoc_coder_pool_t pool);
+
+/// Takes a coder from the pool. An idle coder is re-initialized with the
+/// current symbols and symbol size of the factory (which can be changed
+/// with kodoc_factory_set_symbols() and kodoc_factory_set_symbol_size()).
+/// If the pool has no idle coders, a new coder is built.
+/// The symbol storage of the coder must be specified again, since it is
+/// reset together with the rest of the coding state.
+/// @param pool The pool to use
+/// @return A coder that is ready for use
+KODOC_API
+kodoc_coder_t kodoc_coder_pool_acquire(kodoc_coder_pool_t pool);
+
+/// Returns a coder to the pool. The coder must be acquired from the same
+/// pool, and it must not be used by the caller after this call.
+/// @param pool The pool to use
+/// @param coder The coder that is no longer used
+KODOC_API
+void kodoc_coder_pool_release(kodoc_coder_pool_t pool, kodoc_coder_t coder);
+
+/// Returns the number of idle coders in the pool
+/// @param pool The pool to query
+/// @return The number of idle coders
+KODOC_API
+uint32_t kodoc_coder_pool_idle(kodoc_coder_pool_t pool);
+
 //------------------------------------------------------------------
 // PAYLOAD API
 //------------------------------------------------------------------
@@ -202,6 +556,20 @@ uint32_t kodoc_payload_size(kodoc_coder_t coder);
 KODOC_API
 void kodoc_read_payload(kodoc_coder_t decoder, uint8_t* payload);
 
+/// Reads a batch of coded symbols into the decoder. The payloads are read
+/// in order, and the function returns as soon as the decoder is complete,
+/// so the remaining (redundant) payloads in the batch are not processed.
+/// @param decoder The decoder to use.
+/// @param payloads Array of count payload pointers. The payload buffers
+///        may be changed by this operation, see kodoc_read_payload().
+/// @param count The number of payloads in the batch
+/// @return The number of payloads that were read by the decoder. This is
+///         less than count if the decoder completed before the end of
+///         the batch, and 0 if the decoder was already complete.
+KODOC_API
+uint32_t kodoc_read_payloads(kodoc_coder_t decoder, uint8_t** payloads,
+                             uint32_t count);
+
 /// Writes a systematic/coded symbol into the provided payload buffer.
 /// @param coder The encoder/decoder to use.
 /// @param payload The buffer which should contain the (re/en)coded
@@ -210,6 +578,25 @@ void kodoc_read_payload(kodoc_coder_t decoder, uint8_t* payload);
 KODOC_API
 uint32_t kodoc_write_payload(kodoc_coder_t coder, uint8_t* payload);
 
+/// Writes several systematic/coded symbols into a contiguous payload buffer.
+/// This is equivalent to calling kodoc_write_payload() count times, but the
+/// coder is only resolved once for the whole batch.
+/// @param coder The encoder/decoder to use.
+/// @param buffer The buffer which should contain the (re/en)coded symbols.
+///        The i'th payload is written at offset i * stride in this buffer.
+/// @param stride The distance in bytes between two consecutive payloads.
+///        This value must be at least kodoc_payload_size().
+/// @param count The number of payloads to write
+/// @param bytes_used Optional array of count elements that will contain the
+///        bytes used from each payload. This can be set to NULL if the
+///        individual payload sizes are not needed.
+/// @return The total bytes used from all payloads. The total is 64-bit,
+///         since count * stride may exceed 32 bits for a large buffer.
+KODOC_API
+uint64_t kodoc_write_payloads(kodoc_coder_t coder, uint8_t* buffer,
+                              uint32_t stride, uint32_t count,
+                              uint32_t* bytes_used);
+
 /// Checks whether the encoder/decoder provides the kodoc_write_payload()
 /// function.
 /// @param coder The encoder/decoder to query
@@ -500,7 +887,10 @@ void kodoc_set_systematic_off(kodoc_coder_t encoder);
 // TRACE API
 //------------------------------------------------------------------
 
-/// Returns whether an encoder or decoder supports the trace interface
+/// Returns whether an encoder or decoder supports the trace interface.
+/// If kodo-c is configured with the "--disable_trace" option, the coders are
+/// built without the trace layers and the other functions in this section
+/// have no effect.
 /// @param coder The encoder/decoder to query
 /// @return Non-zero value if tracing is supported, otherwise 0
 KODOC_API
@@ -539,6 +929,139 @@ void kodoc_set_trace_off(kodoc_coder_t coder);
 KODOC_API
 void kodoc_set_zone_prefix(kodoc_coder_t coder, const char* prefix);
 
+//------------------------------------------------------------------
+// COUNTERS API
+//------------------------------------------------------------------
+
+/// Copies the counters of an encoder or decoder. Every coder counts the
+/// payloads that pass through kodoc_write_payload() and
+/// kodoc_read_payload() (including the batch functions) and the time spent
+/// in these calls. The counters are kept in plain fields without locking,
+/// so they can be left enabled in production, and they are cleared when
+/// the coder is built or recycled by a coder pool.
+/// The counters are only updated by the thread that uses the coder. If
+/// they are read from another thread, a value may be slightly out of date.
+/// Payloads written by a decoder (recoding) are not counted.
+/// @param coder The encoder/decoder to query
+/// @param counters The struct that receives the counters
+KODOC_API
+void kodoc_get_counters(kodoc_coder_t coder, kodoc_counters_t* counters);
+
+/// Sets all counters of an encoder or decoder to zero
+/// @param coder The encoder/decoder to reset
+KODOC_API
+void kodoc_reset_counters(kodoc_coder_t coder);
+
+//------------------------------------------------------------------
+// EVENT RING API
+//------------------------------------------------------------------
+
+/// Builds a new event ring, which receives the trace events of a coder as
+/// fixed-size binary records. Unlike the trace callbacks, no strings are
+/// formatted, so the events can be recorded in production and decoded
+/// later, e.g. after a failure.
+/// The ring is lock-free with a single producer (the thread that uses the
+/// coder) and a single consumer (the thread that calls
+/// kodoc_read_events()). When the ring is full, the oldest events are
+/// overwritten, so it always holds the latest events.
+/// @param capacity The minimum number of events in the ring. The capacity
+///        is rounded up to a power of two.
+/// @return A new event ring
+KODOC_API
+kodoc_event_ring_t kodoc_new_event_ring(uint32_t capacity);
+
+/// Releases the memory consumed by an event ring. The ring must be
+/// detached from its coder before it is deleted.
+/// @param ring The event ring which should be deallocated
+KODOC_API
+void kodoc_delete_event_ring(kodoc_event_ring_t ring);
+
+/// Returns the number of events that the ring can hold
+/// @param ring The event ring to query
+/// @return The capacity of the ring
+KODOC_API
+uint32_t kodoc_event_ring_capacity(kodoc_event_ring_t ring);
+
+/// Attaches an event ring to an encoder or decoder. The coder records an
+/// event for every payload written or read and for every uncoded symbol
+/// read. The ring is detached when the coder is recycled by a coder pool.
+/// @param coder The encoder/decoder to use
+/// @param ring The event ring, or NULL to stop recording events. A ring
+///        can only be attached to a single coder at a time.
+KODOC_API
+void kodoc_set_event_ring(kodoc_coder_t coder, kodoc_event_ring_t ring);
+
+/// Copies the oldest unread events from the ring in the order they were
+/// recorded, and removes them from the ring
+/// @param ring The event ring to read from
+/// @param events The array that receives the events
+/// @param max_events The maximum number of events to copy
+/// @return The number of events copied
+KODOC_API
+uint32_t kodoc_read_events(kodoc_event_ring_t ring, kodoc_event_t* events,
+                           uint32_t max_events);
+
+/// Returns the number of events that were overwritten before they were
+/// read
+/// @param ring The event ring to query
+/// @return The number of lost events
+KODOC_API
+uint64_t kodoc_event_ring_dropped(kodoc_event_ring_t ring);
+
+//------------------------------------------------------------------
+// DECODER SNAPSHOT API
+//------------------------------------------------------------------
+
+/// Check whether the decoder can save its decoding state with
+/// kodoc_decoder_snapshot(). This is supported by the full_vector,
+/// sparse_full_vector, on_the_fly, seed and sparse_seed decoders.
+/// @param decoder The decoder to query
+/// @return Non-zero if the decoder supports snapshots, otherwise 0
+KODOC_API
+uint8_t kodoc_has_snapshot_interface(kodoc_coder_t decoder);
+
+/// Returns the size of the snapshot that kodoc_decoder_snapshot() would
+/// write for the current state of the decoder. The snapshot holds a row
+/// for every pivot symbol, so its size grows with the rank.
+/// @param decoder The decoder to query
+/// @return The size of the snapshot in bytes
+KODOC_API
+uint32_t kodoc_decoder_snapshot_size(kodoc_coder_t decoder);
+
+/// Saves the decoding state to a compact binary blob, which can be stored
+/// to checkpoint a long transfer. The snapshot contains the rows of the
+/// decoding matrix with their symbol data, and the pivot and uncoded
+/// status of every symbol (the state behind kodoc_is_symbol_pivot() and
+/// kodoc_is_symbol_uncoded()). The integers in the blob are stored in big
+/// endian byte order, so it can be restored on another platform.
+/// @param decoder The decoder to save
+/// @param buffer The buffer that receives the snapshot. It must hold at
+///        least kodoc_decoder_snapshot_size() bytes.
+/// @return The number of bytes written to the buffer
+KODOC_API
+uint32_t kodoc_decoder_snapshot(kodoc_coder_t decoder, uint8_t* buffer);
+
+/// Restores a snapshot in a new decoder. The rows of the snapshot are
+/// read by the decoder like coded symbols, so the payloads received before
+/// the snapshot are not needed again. Every row goes through the Gaussian
+/// elimination of the decoder, so the restore costs O(rank^2 * symbol
+/// size) operations in the worst case. It is not a plain copy, but the
+/// stored rows are already reduced, so most of the work is skipped.
+/// The decoder must be built with the same codec, finite field, symbols
+/// and symbol size as the decoder that wrote the snapshot, its storage
+/// must be set and it must not have received any data. After a
+/// successful restore, the decoder continues with the next payload.
+/// @param decoder The decoder that receives the state
+/// @param buffer The snapshot
+/// @param size The size of the snapshot in bytes
+/// @return Non-zero if the snapshot was restored. 0 is returned if the
+///         snapshot does not match the decoder or is damaged; the decoder
+///         should be deleted in that case, as it may hold parts of the
+///         snapshot.
+KODOC_API
+uint8_t kodoc_decoder_restore(kodoc_coder_t decoder, const uint8_t* buffer,
+                              uint32_t size);
+
 //------------------------------------------------------------------
 // SPARSE ENCODER API
 //------------------------------------------------------------------
@@ -658,6 +1181,740 @@ uint32_t kodoc_factory_max_inner_symbols(kodoc_factory_t factory);
 KODOC_API
 void kodoc_factory_set_expansion(kodoc_factory_t factory, uint32_t expansion);
 
+//------------------------------------------------------------------
+// OBJECT ENCODER API
+//------------------------------------------------------------------
+
+/// Builds a new object encoder that splits an object of arbitrary size into
+/// blocks (generations) and encodes every block independently.
+/// The object is divided into symbols of kodoc_factory_max_symbol_size()
+/// bytes, and these symbols are spread evenly over the smallest number of
+/// blocks that contain at most kodoc_factory_max_symbols() symbols each.
+/// The number of symbols in two blocks differs by at most one. The block
+/// encoders are built from the factory when they are first used.
+/// While the systematic mode of a block encoder is on, the object encoder
+/// sends the source symbols of the block with its own header, so that they
+/// can also be sent without copying (see
+/// kodoc_object_encoder_write_payload_iov()).
+/// @param factory The encoder factory that is used to build the block
+///        encoders. The factory must not be deleted before the object encoder.
+/// @param data The buffer containing the object to be encoded. The buffer
+///        is not copied, so it must remain valid until the object encoder
+///        is deleted.
+/// @param size The size of the object in bytes
+/// @return A new object encoder
+KODOC_API
+kodoc_object_encoder_t kodoc_new_object_encoder(
+    kodoc_factory_t factory, uint8_t* data, uint64_t size);
+
+/// Deallocates and releases the memory consumed by an object encoder and
+/// all of its block encoders
+/// @param encoder The object encoder which should be deallocated
+KODOC_API
+void kodoc_delete_object_encoder(kodoc_object_encoder_t encoder);
+
+/// Returns the number of blocks in the object
+/// @param encoder The object encoder to query
+/// @return The number of blocks
+KODOC_API
+uint32_t kodoc_object_encoder_blocks(kodoc_object_encoder_t encoder);
+
+/// Returns the number of symbols in a block
+/// @param encoder The object encoder to query
+/// @param block The index of the block
+/// @return The number of symbols in the block
+KODOC_API
+uint32_t kodoc_object_encoder_block_symbols(
+    kodoc_object_encoder_t encoder, uint32_t block);
+
+/// Returns the maximum size of a payload written by the object encoder.
+/// This includes the block id that is prepended to every payload.
+/// @param encoder The object encoder to query
+/// @return The required payload buffer size in bytes
+KODOC_API
+uint32_t kodoc_object_encoder_payload_size(kodoc_object_encoder_t encoder);
+
+/// Returns the encoder of a block, e.g. to configure the systematic mode.
+/// The encoder is owned by the object encoder and must not be deleted.
+/// @param encoder The object encoder to query
+/// @param block The index of the block
+/// @return The encoder of the block
+KODOC_API
+kodoc_coder_t kodoc_object_encoder_coder(
+    kodoc_object_encoder_t encoder, uint32_t block);
+
+/// Writes a payload for the given block into the provided buffer. The
+/// payload starts with the block id, so it can be passed to
+/// kodoc_object_decoder_read_payload() at the receiver.
+/// @param encoder The object encoder to use
+/// @param block The index of the block that should be encoded
+/// @param payload The buffer which should contain the payload
+/// @return The total bytes used from the payload buffer
+KODOC_API
+uint32_t kodoc_object_encoder_write_payload(
+    kodoc_object_encoder_t encoder, uint32_t block, uint8_t* payload);
+
+/// Writes a payload for the given block as a scatter/gather list, so that
+/// the source symbols can be sent without copying them, e.g. with sendmsg().
+/// While the systematic mode of the block encoder is on, the object encoder
+/// sends the source symbols of the block itself: only a small header is
+/// written to the payload buffer, and the second entry of the list points
+/// to the source symbol in the object data. When all source symbols are
+/// sent, the systematic mode of the block encoder is switched off. A coded
+/// payload is written to the payload buffer and is the only entry.
+/// The concatenated entries form a regular object payload, so the receiver
+/// uses kodoc_object_decoder_read_payload().
+/// @param encoder The object encoder to use
+/// @param block The index of the block that should be encoded
+/// @param payload The buffer for the header or the coded payload. It must
+///        have room for kodoc_object_encoder_payload_size() bytes.
+/// @param iov The list of buffers that make up the payload. It must have
+///        room for 2 entries. The entries are valid until the next payload
+///        is written to the same payload buffer.
+/// @return The number of entries used in the list (1 or 2)
+KODOC_API
+uint32_t kodoc_object_encoder_write_payload_iov(
+    kodoc_object_encoder_t encoder, uint32_t block, uint8_t* payload,
+    kodoc_iovec_t* iov);
+
+//------------------------------------------------------------------
+// OBJECT DECODER API
+//------------------------------------------------------------------
+
+/// Builds a new object decoder that reassembles an object that is encoded
+/// with an object encoder. The decoder must use a factory with the same
+/// codec, field, max_symbols and max_symbol_size as the encoder, and the
+/// same object size, so that both sides arrive at the same blocks.
+/// The block decoders are built when the first payload of a block is
+/// received, and they are released as soon as the block is complete.
+/// @param factory The decoder factory that is used to build the block
+///        decoders. The factory must not be deleted before the object decoder.
+/// @param data The buffer where the object should be decoded. It must
+///        remain valid until the object decoder is deleted.
+/// @param size The size of the object in bytes
+/// @return A new object decoder
+KODOC_API
+kodoc_object_decoder_t kodoc_new_object_decoder(
+    kodoc_factory_t factory, uint8_t* data, uint64_t size);
+
+/// Deallocates and releases the memory consumed by an object decoder and
+/// all of its block decoders
+/// @param decoder The object decoder which should be deallocated
+KODOC_API
+void kodoc_delete_object_decoder(kodoc_object_decoder_t decoder);
+
+/// Returns the number of blocks in the object
+/// @param decoder The object decoder to query
+/// @return The number of blocks
+KODOC_API
+uint32_t kodoc_object_decoder_blocks(kodoc_object_decoder_t decoder);
+
+/// Returns the number of symbols in a block
+/// @param decoder The object decoder to query
+/// @param block The index of the block
+/// @return The number of symbols in the block
+KODOC_API
+uint32_t kodoc_object_decoder_block_symbols(
+    kodoc_object_decoder_t decoder, uint32_t block);
+
+/// Returns the maximum size of a payload read by the object decoder
+/// @param decoder The object decoder to query
+/// @return The required payload buffer size in bytes
+KODOC_API
+uint32_t kodoc_object_decoder_payload_size(kodoc_object_decoder_t decoder);
+
+/// Returns the decoder of a block. The decoder is built if needed, and it
+/// is owned by the object decoder, so it must not be deleted.
+/// @param decoder The object decoder to query
+/// @param block The index of the block
+/// @return The decoder of the block, or 0 if the block is already complete
+KODOC_API
+kodoc_coder_t kodoc_object_decoder_coder(
+    kodoc_object_decoder_t decoder, uint32_t block);
+
+/// Reads a payload that was written by an object encoder. The payload is
+/// passed to the decoder of its block. Payloads for blocks that are already
+/// complete are ignored.
+/// @param decoder The object decoder to use
+/// @param payload The buffer storing the payload. The buffer may be changed
+///        by this operation.
+/// @return The index of the block that the payload belongs to
+KODOC_API
+uint32_t kodoc_object_decoder_read_payload(
+    kodoc_object_decoder_t decoder, uint8_t* payload);
+
+/// Checks whether a block is fully decoded
+/// @param decoder The object decoder to query
+/// @param block The index of the block
+/// @return Non-zero value if the block is complete, otherwise 0
+KODOC_API
+uint8_t kodoc_object_decoder_is_block_complete(
+    kodoc_object_decoder_t decoder, uint32_t block);
+
+/// Checks whether the entire object is decoded
+/// @param decoder The object decoder to query
+/// @return Non-zero value if all blocks are complete, otherwise 0
+KODOC_API
+uint8_t kodoc_object_decoder_is_complete(kodoc_object_decoder_t decoder);
+
+//------------------------------------------------------------------
+// PARALLEL ENCODER API
+//------------------------------------------------------------------
+
+/// Builds a new parallel encoder that splits an object into blocks in the
+/// same way as kodoc_new_object_encoder(), and encodes the blocks on a pool
+/// of worker threads. Every block has an encoder and a ring of ready
+/// payloads. Whenever a payload is taken from a ring, a task that refills
+/// the ring is queued on the pool. Every worker has its own task queue, and
+/// idle workers steal tasks from the other workers.
+/// The payloads are compatible with kodoc_object_decoder_read_payload().
+/// @param factory The encoder factory that is used to build the block
+///        encoders. All encoders are built before this function returns.
+/// @param data The buffer containing the object to be encoded. The buffer
+///        is not copied, so it must remain valid until the parallel encoder
+///        is deleted.
+/// @param size The size of the object in bytes
+/// @param ring_size The number of ready payloads kept for every block
+/// @param threads The number of worker threads. If 0, one worker is started
+///        for every hardware thread.
+/// @param cpus Optional array with one CPU core index per worker thread.
+///        Worker i is pinned to core cpus[i] (only supported on Linux).
+///        If NULL, the workers are not pinned. The core indices are copied,
+///        so the array only needs to be valid during the call.
+/// @return A new parallel encoder
+KODOC_API
+kodoc_parallel_encoder_t kodoc_new_parallel_encoder(
+    kodoc_factory_t factory, uint8_t* data, uint64_t size,
+    uint32_t ring_size, uint32_t threads, const uint32_t* cpus);
+
+/// Stops the worker threads and releases the memory consumed by a parallel
+/// encoder and all of its block encoders
+/// @param encoder The parallel encoder which should be deallocated
+KODOC_API
+void kodoc_delete_parallel_encoder(kodoc_parallel_encoder_t encoder);
+
+/// Returns the number of blocks in the object
+/// @param encoder The parallel encoder to query
+/// @return The number of blocks
+KODOC_API
+uint32_t kodoc_parallel_encoder_blocks(kodoc_parallel_encoder_t encoder);
+
+/// Returns the number of worker threads
+/// @param encoder The parallel encoder to query
+/// @return The number of worker threads
+KODOC_API
+uint32_t kodoc_parallel_encoder_threads(kodoc_parallel_encoder_t encoder);
+
+/// Returns the maximum size of a payload written by the parallel encoder.
+/// This includes the block id that is prepended to every payload.
+/// @param encoder The parallel encoder to query
+/// @return The required payload buffer size in bytes
+KODOC_API
+uint32_t kodoc_parallel_encoder_payload_size(
+    kodoc_parallel_encoder_t encoder);
+
+/// Copies the next ready payload of a block into the provided buffer.
+/// If the ring of the block is empty, the call blocks until a worker has
+/// produced a payload. Payloads of different blocks can be requested
+/// concurrently from several threads.
+/// @param encoder The parallel encoder to use
+/// @param block The index of the block
+/// @param payload The buffer which should contain the payload
+/// @return The total bytes used from the payload buffer
+KODOC_API
+uint32_t kodoc_parallel_encoder_write_payload(
+    kodoc_parallel_encoder_t encoder, uint32_t block, uint8_t* payload);
+
+//------------------------------------------------------------------
+// PARALLEL DECODER API
+//------------------------------------------------------------------
+
+/// Builds a new parallel decoder that reassembles an object that is encoded
+/// with an object encoder or a parallel encoder. The incoming payloads are
+/// routed by their block id to a set of worker threads. Block i is owned by
+/// worker (i % threads), which builds and uses the decoder of that block,
+/// so the decoding work of different blocks runs on different cores.
+/// @param factory The decoder factory that is used to build the block
+///        decoders. It must not be used by the application while the
+///        parallel decoder exists.
+/// @param data The buffer where the object should be decoded. It must
+///        remain valid until the parallel decoder is deleted.
+/// @param size The size of the object in bytes
+/// @param threads The number of worker threads. If 0, one worker is started
+///        for every hardware thread.
+/// @param cpus Optional array with one CPU core index per worker thread.
+///        Worker i is pinned to core cpus[i] (only supported on Linux).
+///        If NULL, the workers are not pinned. The core indices are copied,
+///        so the array only needs to be valid during the call.
+/// @param callback Optional callback that is invoked on the worker thread
+///        when a block is complete. The decoded data of the block is
+///        available in the object buffer at this point, so it can be
+///        processed while the other blocks are still being decoded.
+///        The callback should return quickly, since it blocks the worker.
+///        If no callback is needed, it can be set to NULL.
+/// @param context A void pointer which is forwarded to the callback function
+/// @return A new parallel decoder
+KODOC_API
+kodoc_parallel_decoder_t kodoc_new_parallel_decoder(
+    kodoc_factory_t factory, uint8_t* data, uint64_t size, uint32_t threads,
+    const uint32_t* cpus, kodoc_block_callback_t callback, void* context);
+
+/// Stops the worker threads and releases the memory consumed by a parallel
+/// decoder. Payloads that are not yet decoded are discarded.
+/// @param decoder The parallel decoder which should be deallocated
+KODOC_API
+void kodoc_delete_parallel_decoder(kodoc_parallel_decoder_t decoder);
+
+/// Returns the number of blocks in the object
+/// @param decoder The parallel decoder to query
+/// @return The number of blocks
+KODOC_API
+uint32_t kodoc_parallel_decoder_blocks(kodoc_parallel_decoder_t decoder);
+
+/// Returns the number of worker threads
+/// @param decoder The parallel decoder to query
+/// @return The number of worker threads
+KODOC_API
+uint32_t kodoc_parallel_decoder_threads(kodoc_parallel_decoder_t decoder);
+
+/// Returns the maximum size of a payload read by the parallel decoder
+/// @param decoder The parallel decoder to query
+/// @return The required payload buffer size in bytes
+KODOC_API
+uint32_t kodoc_parallel_decoder_payload_size(
+    kodoc_parallel_decoder_t decoder);
+
+/// Queues a payload for decoding. The payload is copied, so the buffer can
+/// be reused as soon as the function returns. Payloads for blocks that are
+/// already complete are dropped without being copied, and so are payloads
+/// that are too short to hold a block header and a symbol. A coded payload
+/// that is shorter than the payload size of its block decoder is dropped
+/// by the worker. This function should only be called from a single
+/// thread.
+/// @param decoder The parallel decoder to use
+/// @param payload The buffer storing the payload
+/// @param size The number of bytes in the payload
+KODOC_API
+void kodoc_parallel_decoder_read_payload(
+    kodoc_parallel_decoder_t decoder, const uint8_t* payload, uint32_t size);
+
+/// Checks whether a block is fully decoded
+/// @param decoder The parallel decoder to query
+/// @param block The index of the block
+/// @return Non-zero value if the block is complete, otherwise 0
+KODOC_API
+uint8_t kodoc_parallel_decoder_is_block_complete(
+    kodoc_parallel_decoder_t decoder, uint32_t block);
+
+/// Returns the number of fully decoded blocks
+/// @param decoder The parallel decoder to query
+/// @return The number of complete blocks
+KODOC_API
+uint32_t kodoc_parallel_decoder_completed_blocks(
+    kodoc_parallel_decoder_t decoder);
+
+/// Checks whether the entire object is decoded
+/// @param decoder The parallel decoder to query
+/// @return Non-zero value if all blocks are complete, otherwise 0
+KODOC_API
+uint8_t kodoc_parallel_decoder_is_complete(kodoc_parallel_decoder_t decoder);
+
+/// Blocks until the entire object is decoded
+/// @param decoder The parallel decoder to use
+KODOC_API
+void kodoc_parallel_decoder_wait(kodoc_parallel_decoder_t decoder);
+
+//------------------------------------------------------------------
+// PREFILL ENCODER API
+//------------------------------------------------------------------
+
+/// Builds a new prefill encoder, which computes the coded payloads of an
+/// encoder ahead of time on a background thread. The worker keeps a ring of
+/// ready payloads full, so that a burst of payloads can be sent without
+/// waiting for the finite field arithmetic of every payload.
+/// The encoder must be fully configured (e.g. the symbols and the
+/// systematic mode must be set) before the prefill encoder is created.
+/// While the prefill encoder exists, the encoder is used by the worker
+/// thread, so it must not be accessed directly.
+/// @param encoder The encoder that produces the payloads. It is not owned
+///        by the prefill encoder and it must outlive the prefill encoder.
+/// @param ring_size The number of ready payloads that are kept
+/// @param cpu Optional pointer to the index of the CPU core that the
+///        worker is pinned to (only supported on Linux). If NULL, the
+///        worker is not pinned.
+/// @return A new prefill encoder
+KODOC_API
+kodoc_prefill_encoder_t kodoc_new_prefill_encoder(
+    kodoc_coder_t encoder, uint32_t ring_size, const uint32_t* cpu);
+
+/// Stops the worker thread and releases the memory consumed by a prefill
+/// encoder. The ready payloads are discarded. The encoder can be used
+/// directly again after this call.
+/// @param encoder The prefill encoder which should be deallocated
+KODOC_API
+void kodoc_delete_prefill_encoder(kodoc_prefill_encoder_t encoder);
+
+/// Returns the maximum size of a payload written by the prefill encoder,
+/// which equals the payload size of the encoder
+/// @param encoder The prefill encoder to query
+/// @return The required payload buffer size in bytes
+KODOC_API
+uint32_t kodoc_prefill_encoder_payload_size(kodoc_prefill_encoder_t encoder);
+
+/// Returns the number of payloads that are ready to be written
+/// @param encoder The prefill encoder to query
+/// @return The number of ready payloads
+KODOC_API
+uint32_t kodoc_prefill_encoder_ready(kodoc_prefill_encoder_t encoder);
+
+/// Copies the oldest ready payload into the provided buffer. If no payload
+/// is ready, the call blocks until the worker has produced one.
+/// @param encoder The prefill encoder to use
+/// @param payload The buffer which should contain the payload
+/// @return The total bytes used from the payload buffer
+KODOC_API
+uint32_t kodoc_prefill_encoder_write_payload(
+    kodoc_prefill_encoder_t encoder, uint8_t* payload);
+
+/// Copies the oldest ready payload into the provided buffer, without
+/// waiting for the worker if no payload is ready
+/// @param encoder The prefill encoder to use
+/// @param payload The buffer which should contain the payload
+/// @return The total bytes used from the payload buffer, or 0 if no
+///         payload was ready
+KODOC_API
+uint32_t kodoc_prefill_encoder_try_write_payload(
+    kodoc_prefill_encoder_t encoder, uint8_t* payload);
+
+//------------------------------------------------------------------
+// RELAY API
+//------------------------------------------------------------------
+
+/// Builds a new relay, which recodes the symbols of a generation at an
+/// intermediate node without Gaussian elimination on the symbol data. The
+/// relay stores the received coded symbols as they are, together with
+/// their coding coefficients, and every recoded symbol is a random linear
+/// combination of the stored symbols. The rank is tracked on the coding
+/// coefficients only: a received symbol that is linearly dependent on the
+/// stored symbols is dropped without touching its symbol data, and an
+/// independent symbol costs one copy or multiply-add of its symbol data.
+/// The relay therefore never loses a degree of freedom that it holds.
+/// Recoding a symbol costs one multiply-add per stored symbol.
+/// The relay works on the symbol API: it reads the symbols written with
+/// kodoc_write_symbol() and kodoc_write_uncoded_symbol(), and the
+/// recoded symbols can be passed to kodoc_read_symbol() at a decoder that
+/// uses the same finite field, symbols and symbol size.
+/// @param finite_field The finite field of the generation
+/// @param symbols The number of symbols in the generation
+/// @param symbol_size The size of a symbol in bytes
+/// @param max_buffered The maximum number of stored symbols. The memory of
+///        all stored symbols and their coefficients is allocated up front.
+///        When the relay is full, an independent received symbol is added
+///        to one of the stored symbols, and the echelon form of the
+///        coefficients is updated from that symbol onwards. The relay
+///        forwards at most max_buffered degrees of freedom of the
+///        generation.
+///        The memory is taken from the global heap, the allocator of a
+///        factory is not used.
+/// @return A new relay
+KODOC_API
+kodoc_relay_t kodoc_new_relay(int32_t finite_field, uint32_t symbols,
+                              uint32_t symbol_size, uint32_t max_buffered);
+
+/// Releases the memory consumed by a relay
+/// @param relay The relay which should be deallocated
+KODOC_API
+void kodoc_delete_relay(kodoc_relay_t relay);
+
+/// Returns the number of symbols in the generation
+/// @param relay The relay to query
+/// @return The number of symbols
+KODOC_API
+uint32_t kodoc_relay_symbols(kodoc_relay_t relay);
+
+/// Returns the symbol size of the relay
+/// @param relay The relay to query
+/// @return The size of a symbol in bytes
+KODOC_API
+uint32_t kodoc_relay_symbol_size(kodoc_relay_t relay);
+
+/// Returns the size of a coefficient vector, which equals
+/// kodoc_coefficient_vector_size() of the coders of the generation
+/// @param relay The relay to query
+/// @return The size of a coefficient vector in bytes
+KODOC_API
+uint32_t kodoc_relay_coefficient_vector_size(kodoc_relay_t relay);
+
+/// Returns the maximum number of stored symbols
+/// @param relay The relay to query
+/// @return The maximum number of stored symbols
+KODOC_API
+uint32_t kodoc_relay_max_buffered(kodoc_relay_t relay);
+
+/// Returns the number of stored symbols, which are linearly independent
+/// @param relay The relay to query
+/// @return The number of stored symbols
+KODOC_API
+uint32_t kodoc_relay_buffered(kodoc_relay_t relay);
+
+/// Returns the number of symbols received since the relay was built or
+/// reset, including the symbols that were mixed into stored symbols or
+/// dropped as linearly dependent
+/// @param relay The relay to query
+/// @return The number of received symbols
+KODOC_API
+uint32_t kodoc_relay_received(kodoc_relay_t relay);
+
+/// Returns the memory allocated for the stored symbols and coefficients,
+/// including the echelon form of the coefficients that tracks the rank
+/// @param relay The relay to query
+/// @return The memory size in bytes
+KODOC_API
+uint32_t kodoc_relay_memory_size(kodoc_relay_t relay);
+
+/// Reads a coded symbol and its coding coefficients. Symbols with only
+/// zero coefficients are ignored.
+/// @param relay The relay to use
+/// @param symbol_data The coded symbol
+/// @param coefficients The coding coefficients of the symbol
+KODOC_API
+void kodoc_relay_read_symbol(kodoc_relay_t relay, const uint8_t* symbol_data,
+                             const uint8_t* coefficients);
+
+/// Reads a systematic/uncoded symbol with the corresponding symbol index
+/// @param relay The relay to use
+/// @param symbol_data The uncoded source symbol
+/// @param index The index of the symbol in the generation
+KODOC_API
+void kodoc_relay_read_uncoded_symbol(
+    kodoc_relay_t relay, const uint8_t* symbol_data, uint32_t index);
+
+/// Writes a recoded symbol and its coding coefficients
+/// @param relay The relay to use
+/// @param symbol_data The destination buffer for the recoded symbol
+/// @param coefficients The destination buffer for the coding coefficients
+/// @return The number of bytes used in the symbol buffer, or 0 if the relay
+///         has not received any symbols yet
+KODOC_API
+uint32_t kodoc_relay_write_symbol(kodoc_relay_t relay, uint8_t* symbol_data,
+                                  uint8_t* coefficients);
+
+/// Forgets all stored symbols, so that the relay can be used for the next
+/// generation. The allocated memory is reused.
+/// @param relay The relay to reset
+KODOC_API
+void kodoc_relay_reset(kodoc_relay_t relay);
+
+//------------------------------------------------------------------
+// BATCH ENCODER API
+//------------------------------------------------------------------
+
+/// Builds a new batch encoder, which encodes a block in the binary field
+/// and computes a batch of coded symbols in one pass over the source
+/// symbols. A coded symbol is the xor of the source symbols with a set
+/// coefficient bit. Up to 32 coded symbols are summed together in tiles
+/// that stay in the cache, so a batch reads the block once per 32 coded
+/// symbols instead of once per coded symbol. The xor kernels are selected
+/// for the CPU at runtime (SSSE3, AVX2, NEON or none), and a batch of at
+/// least 1 MB of coded symbols is written with non-temporal stores, which
+/// keep the source symbols in the cache.
+/// The coded symbols and their coefficient vectors can be passed to
+/// kodoc_read_symbol() at a decoder that uses the binary field with the
+/// same symbols and symbol size.
+/// The tile buffers are allocated on the global heap when the batch
+/// encoder is built, the allocator of a factory is not used.
+/// @param symbols The number of symbols in the block
+/// @param symbol_size The size of a symbol in bytes
+/// @return A new batch encoder
+KODOC_API
+kodoc_batch_encoder_t kodoc_new_batch_encoder(uint32_t symbols,
+                                              uint32_t symbol_size);
+
+/// Releases the memory consumed by a batch encoder
+/// @param encoder The batch encoder which should be deallocated
+KODOC_API
+void kodoc_delete_batch_encoder(kodoc_batch_encoder_t encoder);
+
+/// Returns the number of symbols in the block
+/// @param encoder The batch encoder to query
+/// @return The number of symbols
+KODOC_API
+uint32_t kodoc_batch_encoder_symbols(kodoc_batch_encoder_t encoder);
+
+/// Returns the symbol size
+/// @param encoder The batch encoder to query
+/// @return The size of a symbol in bytes
+KODOC_API
+uint32_t kodoc_batch_encoder_symbol_size(kodoc_batch_encoder_t encoder);
+
+/// Returns the block size, which is the size of the source symbols
+/// @param encoder The batch encoder to query
+/// @return The block size in bytes
+KODOC_API
+uint32_t kodoc_batch_encoder_block_size(kodoc_batch_encoder_t encoder);
+
+/// Returns the size of a coefficient vector, which holds one bit per
+/// symbol with the first symbol in the lowest bit
+/// @param encoder The batch encoder to query
+/// @return The size of a coefficient vector in bytes
+KODOC_API
+uint32_t kodoc_batch_encoder_coefficient_vector_size(
+    kodoc_batch_encoder_t encoder);
+
+/// Sets the source symbols. The data is not copied, so it must stay valid
+/// while the batch encoder is used.
+/// @param encoder The batch encoder to use
+/// @param data The buffer containing the source symbols
+/// @param size The size of the buffer, which must equal the block size
+KODOC_API
+void kodoc_batch_encoder_set_const_symbols(
+    kodoc_batch_encoder_t encoder, const uint8_t* data, uint32_t size);
+
+/// Writes a batch of coded symbols with random coefficients
+/// @param encoder The batch encoder to use
+/// @param symbol_data The buffer of the coded symbols, which are stored
+///        back to back. It must hold count * symbol size bytes.
+/// @param coefficients The buffer of the coefficient vectors, which are
+///        stored back to back. It must hold count * coefficient vector
+///        size bytes.
+/// @param count The number of coded symbols
+/// @return The total bytes used from the symbol buffer
+KODOC_API
+uint32_t kodoc_batch_encoder_write_symbols(
+    kodoc_batch_encoder_t encoder, uint8_t* symbol_data,
+    uint8_t* coefficients, uint32_t count);
+
+//------------------------------------------------------------------
+// FILE ENCODER API
+//------------------------------------------------------------------
+
+/// Opens a file for encoding. The file is mapped into memory and split
+/// into blocks like an object encoder, and the block encoders use the mapped
+/// pages directly, so the file data is not copied. When a block is first
+/// encoded, the pages of the next block are prefetched and the pages of the
+/// previous block are removed from the resident set of the process, since
+/// blocks are typically sent in order. The data stays in the page cache, so
+/// a later payload for the previous block maps its pages in again.
+/// Note: memory mapped files are only supported on POSIX systems.
+/// @param factory The encoder factory that is used to build the block
+///        encoders. The factory must not be deleted before the file encoder.
+/// @param path The path of the file that should be encoded. The file must
+///        not be empty or modified while it is being encoded.
+/// @return A new file encoder, or 0 if the file could not be mapped
+KODOC_API
+kodoc_file_encoder_t kodoc_file_encoder_open(
+    kodoc_factory_t factory, const char* path);
+
+/// Unmaps the file and releases the memory consumed by a file encoder
+/// @param encoder The file encoder which should be closed
+KODOC_API
+void kodoc_file_encoder_close(kodoc_file_encoder_t encoder);
+
+/// Returns the size of the encoded file. The decoder needs this to open
+/// the destination file.
+/// @param encoder The file encoder to query
+/// @return The size of the file in bytes
+KODOC_API
+uint64_t kodoc_file_encoder_file_size(kodoc_file_encoder_t encoder);
+
+/// Returns the number of blocks in the file
+/// @param encoder The file encoder to query
+/// @return The number of blocks
+KODOC_API
+uint32_t kodoc_file_encoder_blocks(kodoc_file_encoder_t encoder);
+
+/// Returns the maximum size of a payload written by the file encoder
+/// @param encoder The file encoder to query
+/// @return The required payload buffer size in bytes
+KODOC_API
+uint32_t kodoc_file_encoder_payload_size(kodoc_file_encoder_t encoder);
+
+/// Returns the encoder of a block, e.g. to configure the systematic mode.
+/// The encoder is owned by the file encoder and must not be deleted.
+/// @param encoder The file encoder to query
+/// @param block The index of the block
+/// @return The encoder of the block
+KODOC_API
+kodoc_coder_t kodoc_file_encoder_coder(
+    kodoc_file_encoder_t encoder, uint32_t block);
+
+/// Writes a payload for the given block into the provided buffer. The
+/// payload has the same format as the payloads of an object encoder.
+/// @param encoder The file encoder to use
+/// @param block The index of the block that should be encoded
+/// @param payload The buffer which should contain the payload
+/// @return The total bytes used from the payload buffer
+KODOC_API
+uint32_t kodoc_file_encoder_write_payload(
+    kodoc_file_encoder_t encoder, uint32_t block, uint8_t* payload);
+
+//------------------------------------------------------------------
+// FILE DECODER API
+//------------------------------------------------------------------
+
+/// Opens a file for decoding. The file is created (or truncated) with the
+/// given size and mapped into memory, and the block decoders write the
+/// decoded symbols directly into the mapped pages. The pages of a block
+/// are removed from the resident set of the process when the block is
+/// complete, while the data stays in the page cache until it is written to
+/// the file.
+/// Note: memory mapped files are only supported on POSIX systems.
+/// @param factory The decoder factory that is used to build the block
+///        decoders. It must match the factory of the encoder.
+/// @param path The path of the destination file
+/// @param size The size of the file in bytes
+/// @return A new file decoder, or 0 if the file could not be created
+KODOC_API
+kodoc_file_decoder_t kodoc_file_decoder_open(
+    kodoc_factory_t factory, const char* path, uint64_t size);
+
+/// Unmaps the file and releases the memory consumed by a file decoder.
+/// The blocks that are not complete are left as they are in the file.
+/// @param decoder The file decoder which should be closed
+KODOC_API
+void kodoc_file_decoder_close(kodoc_file_decoder_t decoder);
+
+/// Returns the size of the decoded file
+/// @param decoder The file decoder to query
+/// @return The size of the file in bytes
+KODOC_API
+uint64_t kodoc_file_decoder_file_size(kodoc_file_decoder_t decoder);
+
+/// Returns the number of blocks in the file
+/// @param decoder The file decoder to query
+/// @return The number of blocks
+KODOC_API
+uint32_t kodoc_file_decoder_blocks(kodoc_file_decoder_t decoder);
+
+/// Returns the maximum size of a payload read by the file decoder
+/// @param decoder The file decoder to query
+/// @return The required payload buffer size in bytes
+KODOC_API
+uint32_t kodoc_file_decoder_payload_size(kodoc_file_decoder_t decoder);
+
+/// Reads a payload that was written by a file encoder
+/// @param decoder The file decoder to use
+/// @param payload The buffer storing the payload. The buffer may be changed
+///        by this operation.
+/// @return The index of the block that the payload belongs to
+KODOC_API
+uint32_t kodoc_file_decoder_read_payload(
+    kodoc_file_decoder_t decoder, uint8_t* payload);
+
+/// Checks whether a block is fully decoded
+/// @param decoder The file decoder to query
+/// @param block The index of the block
+/// @return Non-zero value if the block is complete, otherwise 0
+KODOC_API
+uint8_t kodoc_file_decoder_is_block_complete(
+    kodoc_file_decoder_t decoder, uint32_t block);
+
+/// Checks whether the entire file is decoded
+/// @param decoder The file decoder to query
+/// @return Non-zero value if all blocks are complete, otherwise 0
+KODOC_API
+uint8_t kodoc_file_decoder_is_complete(kodoc_file_decoder_t decoder);
+
 #ifdef __cplusplus
 }
 #endif
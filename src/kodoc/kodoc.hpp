@@ -0,0 +1,315 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+/// @file kodoc.hpp
+///
+/// A header-only C++ API with the codec and the finite field selected at
+/// compile time. The encoder and decoder types instantiate the kodo
+/// stacks directly, without the opaque handles, the runtime field
+/// selection and the API bindings of the C API, so the compiler can
+/// inline the coding operations into the caller.
+///
+/// The C API in kodoc.h remains the stable interface of kodo-c: this
+/// header is compiled into the application, so it requires the kodo
+/// headers, and it has to be rebuilt when kodo changes. The coders of
+/// this header cannot be passed to the C API.
+///
+/// Only the RLNC codecs without a nested stack are available here:
+/// full_vector, on_the_fly, sliding_window, sparse_full_vector, seed,
+/// sparse_seed and perpetual. The fulcrum and reed_solomon codecs need
+/// extra configuration or support fewer fields, so they are only
+/// available through the C API.
+
+#include <cstdint>
+#include <memory>
+
+#include <fifi/binary.hpp>
+#include <fifi/binary4.hpp>
+#include <fifi/binary8.hpp>
+#include <storage/storage.hpp>
+
+#if !defined(KODOC_DISABLE_RLNC)
+#include <kodo_rlnc/full_vector_decoder.hpp>
+#include <kodo_rlnc/full_vector_encoder.hpp>
+#include <kodo_rlnc/on_the_fly_decoder.hpp>
+#include <kodo_rlnc/on_the_fly_encoder.hpp>
+#include <kodo_rlnc/perpetual_decoder.hpp>
+#include <kodo_rlnc/perpetual_encoder.hpp>
+#include <kodo_rlnc/seed_decoder.hpp>
+#include <kodo_rlnc/seed_encoder.hpp>
+#include <kodo_rlnc/sliding_window_decoder.hpp>
+#include <kodo_rlnc/sliding_window_encoder.hpp>
+#include <kodo_rlnc/sparse_full_vector_encoder.hpp>
+#include <kodo_rlnc/sparse_seed_decoder.hpp>
+#include <kodo_rlnc/sparse_seed_encoder.hpp>
+#endif
+
+namespace kodoc
+{
+/// The finite fields, which match the kodoc_finite_field values
+namespace field
+{
+using binary = fifi::binary;
+using binary4 = fifi::binary4;
+using binary8 = fifi::binary8;
+}
+
+/// The codecs, which match the kodoc_codec values. A codec selects the
+/// kodo stacks of its encoder and decoder.
+namespace codec
+{
+#if !defined(KODOC_DISABLE_RLNC)
+
+#if !defined(KODOC_DISABLE_FULL_VECTOR)
+struct full_vector
+{
+    template<class Field>
+    using encoder = kodo_rlnc::full_vector_encoder<Field>;
+
+    template<class Field>
+    using decoder = kodo_rlnc::full_vector_decoder<Field>;
+};
+#endif
+
+#if !defined(KODOC_DISABLE_ON_THE_FLY)
+struct on_the_fly
+{
+    template<class Field>
+    using encoder = kodo_rlnc::on_the_fly_encoder<Field>;
+
+    template<class Field>
+    using decoder = kodo_rlnc::on_the_fly_decoder<Field>;
+};
+#endif
+
+#if !defined(KODOC_DISABLE_SLIDING_WINDOW)
+struct sliding_window
+{
+    // The feedback of the sliding window codec is available through
+    // stack()
+    template<class Field>
+    using encoder = kodo_rlnc::sliding_window_encoder<Field>;
+
+    template<class Field>
+    using decoder = kodo_rlnc::sliding_window_decoder<Field>;
+};
+#endif
+
+#if !defined(KODOC_DISABLE_SPARSE_FULL_VECTOR)
+struct sparse_full_vector
+{
+    template<class Field>
+    using encoder = kodo_rlnc::sparse_full_vector_encoder<Field>;
+
+    // The sparse_full_vector codec uses the standard full_vector decoder
+    template<class Field>
+    using decoder = kodo_rlnc::full_vector_decoder<Field>;
+};
+#endif
+
+#if !defined(KODOC_DISABLE_SEED)
+struct seed
+{
+    template<class Field>
+    using encoder = kodo_rlnc::seed_encoder<Field>;
+
+    template<class Field>
+    using decoder = kodo_rlnc::seed_decoder<Field>;
+};
+#endif
+
+#if !defined(KODOC_DISABLE_SPARSE_SEED)
+struct sparse_seed
+{
+    template<class Field>
+    using encoder = kodo_rlnc::sparse_seed_encoder<Field>;
+
+    template<class Field>
+    using decoder = kodo_rlnc::sparse_seed_decoder<Field>;
+};
+#endif
+
+#if !defined(KODOC_DISABLE_PERPETUAL)
+struct perpetual
+{
+    template<class Field>
+    using encoder = kodo_rlnc::perpetual_encoder<Field>;
+
+    template<class Field>
+    using decoder = kodo_rlnc::perpetual_decoder<Field>;
+};
+#endif
+
+#endif
+}
+
+/// Base class with the operations that are shared by encoders and
+/// decoders. A coder owns the factory that built it and its kodo stack.
+/// A coder can be moved but not copied, since a copy would share the
+/// stack and the coding state of the original.
+template<class Stack>
+class basic_coder
+{
+public:
+
+    using stack_type = Stack;
+    using factory_type = typename Stack::factory;
+
+    /// @param symbols The number of symbols in a block
+    /// @param symbol_size The size of a symbol in bytes
+    basic_coder(uint32_t symbols, uint32_t symbol_size) :
+        m_factory(symbols, symbol_size),
+        m_coder(m_factory.build())
+    { }
+
+    basic_coder(const basic_coder&) = delete;
+    basic_coder& operator=(const basic_coder&) = delete;
+
+    basic_coder(basic_coder&&) = default;
+    basic_coder& operator=(basic_coder&&) = default;
+
+    uint32_t symbols() const
+    {
+        return m_coder->symbols();
+    }
+
+    uint32_t symbol_size() const
+    {
+        return m_coder->symbol_size();
+    }
+
+    uint32_t block_size() const
+    {
+        return m_coder->block_size();
+    }
+
+    uint32_t payload_size() const
+    {
+        return m_coder->payload_size();
+    }
+
+    uint32_t coefficient_vector_size() const
+    {
+        return m_coder->coefficient_vector_size();
+    }
+
+    uint32_t rank() const
+    {
+        return m_coder->rank();
+    }
+
+    /// @return The kodo stack, for the operations that are not wrapped
+    stack_type& stack()
+    {
+        return *m_coder;
+    }
+
+protected:
+
+    factory_type m_factory;
+    std::shared_ptr<stack_type> m_coder;
+};
+
+/// An encoder with the codec and the finite field selected at compile time
+template<class Codec, class Field>
+class encoder : public basic_coder<typename Codec::template encoder<Field>>
+{
+public:
+
+    using basic_coder<typename Codec::template encoder<Field>>::basic_coder;
+
+    /// Sets the data that is encoded. The data is not copied, so it must
+    /// stay valid while the encoder is used.
+    void set_const_symbols(const uint8_t* data, uint32_t size)
+    {
+        this->m_coder->set_const_symbols(storage::storage(data, size));
+    }
+
+    /// Writes a payload to the buffer
+    /// @return The number of bytes used
+    uint32_t write_payload(uint8_t* payload)
+    {
+        return this->m_coder->write_payload(payload);
+    }
+
+    /// Writes a source symbol to the buffer
+    /// @return The number of bytes used
+    uint32_t write_uncoded_symbol(uint8_t* symbol_data, uint32_t index)
+    {
+        return this->m_coder->write_uncoded_symbol(symbol_data, index);
+    }
+
+    bool is_systematic_on() const
+    {
+        return this->m_coder->is_systematic_on();
+    }
+
+    void set_systematic_on()
+    {
+        this->m_coder->set_systematic_on();
+    }
+
+    void set_systematic_off()
+    {
+        this->m_coder->set_systematic_off();
+    }
+};
+
+/// A decoder with the codec and the finite field selected at compile time
+template<class Codec, class Field>
+class decoder : public basic_coder<typename Codec::template decoder<Field>>
+{
+public:
+
+    using basic_coder<typename Codec::template decoder<Field>>::basic_coder;
+
+    /// Sets the buffer that receives the decoded data
+    void set_mutable_symbols(uint8_t* data, uint32_t size)
+    {
+        this->m_coder->set_mutable_symbols(storage::storage(data, size));
+    }
+
+    /// Reads a payload. The payload buffer may be changed by the decoder.
+    void read_payload(uint8_t* payload)
+    {
+        this->m_coder->read_payload(payload);
+    }
+
+    /// Reads a source symbol
+    void read_uncoded_symbol(uint8_t* symbol_data, uint32_t index)
+    {
+        this->m_coder->read_uncoded_symbol(symbol_data, index);
+    }
+
+    /// Writes a recoded payload to the buffer
+    /// @return The number of bytes used
+    uint32_t write_payload(uint8_t* payload)
+    {
+        return this->m_coder->write_payload(payload);
+    }
+
+    bool is_complete() const
+    {
+        return this->m_coder->is_complete();
+    }
+
+    bool is_symbol_pivot(uint32_t index) const
+    {
+        return this->m_coder->is_symbol_pivot(index);
+    }
+
+    bool is_symbol_uncoded(uint32_t index) const
+    {
+        return this->m_coder->is_symbol_uncoded(index);
+    }
+
+    uint32_t symbols_uncoded() const
+    {
+        return this->m_coder->symbols_uncoded();
+    }
+};
+}
@@ -0,0 +1,188 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+
+#if !defined(_WIN32)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace kodoc
+{
+/// A file that is mapped into memory in its entirety. Memory mapping is only
+/// supported on POSIX systems, on other platforms the files cannot be
+/// opened.
+class mapped_file
+{
+public:
+
+    mapped_file() :
+        m_data(nullptr),
+        m_size(0)
+    { }
+
+    ~mapped_file()
+    {
+        close();
+    }
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    /// Maps an existing file for reading. The kernel is told that the
+    /// file will be read sequentially, so it reads ahead aggressively.
+    /// @param path The path of the file
+    /// @return true if the file was mapped, otherwise false. Empty files
+    ///         cannot be mapped.
+    bool open_read(const char* path)
+    {
+#if !defined(_WIN32)
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0)
+            return false;
+
+        struct stat status;
+        if (fstat(fd, &status) != 0 || status.st_size <= 0)
+        {
+            ::close(fd);
+            return false;
+        }
+
+        bool mapped = map(fd, (uint64_t) status.st_size, PROT_READ);
+        ::close(fd);
+
+        if (mapped)
+            madvise(m_data, m_size, MADV_SEQUENTIAL);
+
+        return mapped;
+#else
+        (void) path;
+        return false;
+#endif
+    }
+
+    /// Creates or truncates a file, resizes it to the given size and maps it
+    /// for reading and writing. The written data ends up in the file.
+    /// @param path The path of the file
+    /// @param size The size of the file in bytes
+    /// @return true if the file was mapped, otherwise false
+    bool open_write(const char* path, uint64_t size)
+    {
+#if !defined(_WIN32)
+        if (size == 0)
+            return false;
+
+        int fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+            return false;
+
+        if (ftruncate(fd, (off_t) size) != 0)
+        {
+            ::close(fd);
+            return false;
+        }
+
+        bool mapped = map(fd, size, PROT_READ | PROT_WRITE);
+        ::close(fd);
+
+        return mapped;
+#else
+        (void) path;
+        (void) size;
+        return false;
+#endif
+    }
+
+    /// Unmaps the file. For writable files, the data stays in the page
+    /// cache and is written to the file by the kernel.
+    void close()
+    {
+#if !defined(_WIN32)
+        if (m_data != nullptr)
+            munmap(m_data, m_size);
+#endif
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+    /// @return The mapped data
+    uint8_t* data() const
+    {
+        return m_data;
+    }
+
+    /// @return The size of the file in bytes
+    uint64_t size() const
+    {
+        return m_size;
+    }
+
+    /// Asks the kernel to read a range of the file into memory in the
+    /// background, so that the first access does not have to wait for I/O
+    void will_need(uint64_t offset, uint64_t size)
+    {
+#if !defined(_WIN32)
+        advise(offset, size, MADV_WILLNEED);
+#else
+        (void) offset;
+        (void) size;
+#endif
+    }
+
+    /// Removes a range of the file from the resident set of the process.
+    /// The pages remain in the page cache (including modified pages of a
+    /// writable file), so they are mapped in again if they are accessed.
+    void dont_need(uint64_t offset, uint64_t size)
+    {
+#if !defined(_WIN32)
+        advise(offset, size, MADV_DONTNEED);
+#else
+        (void) offset;
+        (void) size;
+#endif
+    }
+
+private:
+
+#if !defined(_WIN32)
+    bool map(int fd, uint64_t size, int protection)
+    {
+        void* data = mmap(nullptr, (size_t) size, protection, MAP_SHARED,
+                          fd, 0);
+
+        if (data == MAP_FAILED)
+            return false;
+
+        m_data = (uint8_t*) data;
+        m_size = size;
+        return true;
+    }
+
+    void advise(uint64_t offset, uint64_t size, int advice)
+    {
+        if (m_data == nullptr || offset >= m_size)
+            return;
+
+        // The advice applies to whole pages, so the range is extended to
+        // the page boundaries
+        uint64_t page_size = (uint64_t) sysconf(_SC_PAGESIZE);
+        uint64_t begin = offset - offset % page_size;
+        uint64_t end = offset + size < m_size ? offset + size : m_size;
+
+        madvise(m_data + begin, (size_t) (end - begin), advice);
+    }
+#endif
+
+private:
+
+    uint8_t* m_data;
+    uint64_t m_size;
+};
+}
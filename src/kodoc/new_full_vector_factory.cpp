@@ -19,6 +19,7 @@
 #include "create_factory.hpp"
 #include "runtime_decoder.hpp"
 #include "runtime_encoder.hpp"
+#include "snapshot_binding.hpp"
 
 namespace kodoc
 {
@@ -49,8 +50,9 @@ kodoc_factory_t new_sparse_full_vector_encoder_factory(
 
 template<class Stack>
 using full_vector_decoder_binding =
+    snapshot_binding<
     kodo_core::api::write_payload_binding<
-    kodo_core::api::symbol_decoding_status_updater_binding<Stack>>;
+    kodo_core::api::symbol_decoding_status_updater_binding<Stack>>>;
 
 kodoc_factory_t new_full_vector_decoder_factory(
     int32_t finite_field, uint32_t max_symbols, uint32_t max_symbol_size)
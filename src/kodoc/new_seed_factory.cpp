@@ -15,6 +15,7 @@
 
 #include "create_factory.hpp"
 #include "runtime_encoder.hpp"
+#include "snapshot_binding.hpp"
 #include "runtime_decoder.hpp"
 
 namespace kodoc
@@ -29,13 +30,18 @@ kodoc_factory_t new_seed_encoder_factory(
                finite_field, max_symbols, max_symbol_size);
 }
 
+template<class Stack>
+using seed_decoder_binding =
+    snapshot_binding<
+    kodo_core::api::symbol_decoding_status_updater_binding<Stack>>;
+
 kodoc_factory_t new_seed_decoder_factory(
     int32_t finite_field, uint32_t max_symbols, uint32_t max_symbol_size)
 {
     return create_factory<
            runtime_decoder<
            kodo_rlnc::seed_decoder,
-           kodo_core::api::symbol_decoding_status_updater_binding>>(
+           seed_decoder_binding>>(
                finite_field, max_symbols, max_symbol_size);
 }
 }
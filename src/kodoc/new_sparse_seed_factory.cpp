@@ -15,6 +15,7 @@
 #include "create_factory.hpp"
 #include "runtime_decoder.hpp"
 #include "runtime_encoder.hpp"
+#include "snapshot_binding.hpp"
 
 namespace kodoc
 {
@@ -33,13 +34,18 @@ kodoc_factory_t new_sparse_seed_encoder_factory(
                finite_field, max_symbols, max_symbol_size);
 }
 
+template<class Stack>
+using sparse_seed_decoder_binding =
+    snapshot_binding<
+    kodo_core::api::symbol_decoding_status_updater_binding<Stack>>;
+
 kodoc_factory_t new_sparse_seed_decoder_factory(
     int32_t finite_field, uint32_t max_symbols, uint32_t max_symbol_size)
 {
     return create_factory<
            runtime_decoder<
            kodo_rlnc::sparse_seed_decoder,
-           kodo_core::api::symbol_decoding_status_updater_binding>>(
+           sparse_seed_decoder_binding>>(
                finite_field, max_symbols, max_symbol_size);
 }
 }
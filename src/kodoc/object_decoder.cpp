@@ -0,0 +1,191 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include "object_decoder.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
+#include "block_header.hpp"
+
+namespace kodoc
+{
+object_decoder::object_decoder(
+    kodoc_factory_t factory, uint8_t* data, uint64_t size) :
+    m_factory(factory),
+    m_partitioning(kodoc_factory_max_symbols(factory),
+                   kodoc_factory_max_symbol_size(factory), size),
+    m_data(data),
+    m_pool(factory),
+    m_coders(m_partitioning.blocks(), nullptr,
+             hook_allocator<kodoc_coder_t>(factory_allocator(factory))),
+    m_complete(m_partitioning.blocks(), 0, m_coders.get_allocator()),
+    m_completed_blocks(0),
+    m_last_block(m_coders.get_allocator())
+{
+    assert(m_factory);
+    assert(m_data);
+
+    uint32_t last = m_partitioning.blocks() - 1;
+
+    // The coders require full symbols, so the last block is decoded into a
+    // zero padded buffer if the object does not fill its last symbol
+    if (m_partitioning.bytes(last) < m_partitioning.block_size(last))
+    {
+        m_last_block.resize(m_partitioning.block_size(last), 0);
+    }
+}
+
+object_decoder::~object_decoder()
+{
+    for (auto coder : m_coders)
+    {
+        if (coder != nullptr)
+            m_pool.release(coder);
+    }
+}
+
+uint32_t object_decoder::payload_size() const
+{
+    return max_object_payload_size(m_factory);
+}
+
+kodoc_coder_t object_decoder::coder(uint32_t block)
+{
+    assert(block < m_coders.size());
+
+    if (m_complete[block] || m_coders[block] != nullptr)
+        return m_coders[block];
+
+    kodoc_coder_t decoder = m_pool.acquire(
+        m_partitioning.symbols(block), m_partitioning.symbol_size());
+
+    uint32_t block_size = m_partitioning.block_size(block);
+    uint8_t* block_data = m_data + m_partitioning.offset(block);
+
+    if (block + 1 == m_partitioning.blocks() && !m_last_block.empty())
+        block_data = m_last_block.data();
+
+    kodoc_set_mutable_symbols(decoder, block_data, block_size);
+
+    m_coders[block] = decoder;
+    return decoder;
+}
+
+uint32_t object_decoder::read_payload(uint8_t* payload)
+{
+    assert(payload);
+
+    uint32_t block = read_block_header(payload);
+
+    if (block >= m_partitioning.blocks() || m_complete[block])
+        return block;
+
+    kodoc_coder_t decoder = coder(block);
+    read_block_payload(decoder, payload);
+
+    if (kodoc_is_complete(decoder))
+        complete_block(block);
+
+    return block;
+}
+
+void object_decoder::complete_block(uint32_t block)
+{
+    assert(!m_complete[block]);
+
+    if (block + 1 == m_partitioning.blocks() && !m_last_block.empty())
+    {
+        memcpy(m_data + m_partitioning.offset(block), m_last_block.data(),
+               m_partitioning.bytes(block));
+        m_last_block.clear();
+        m_last_block.shrink_to_fit();
+    }
+
+    // The decoded data is in the object buffer, so the decoder can be
+    // reused for the next block immediately
+    m_pool.release(m_coders[block]);
+    m_coders[block] = nullptr;
+
+    m_complete[block] = 1;
+    ++m_completed_blocks;
+}
+}
+
+//------------------------------------------------------------------
+// OBJECT DECODER API
+//------------------------------------------------------------------
+
+kodoc_object_decoder_t kodoc_new_object_decoder(
+    kodoc_factory_t factory, uint8_t* data, uint64_t size)
+{
+    assert(factory);
+    assert(data);
+    assert(size > 0);
+    return (kodoc_object_decoder_t) new kodoc::object_decoder(
+        factory, data, size);
+}
+
+void kodoc_delete_object_decoder(kodoc_object_decoder_t decoder)
+{
+    auto object = (kodoc::object_decoder*) decoder;
+    assert(object);
+    delete object;
+}
+
+uint32_t kodoc_object_decoder_blocks(kodoc_object_decoder_t decoder)
+{
+    auto object = (kodoc::object_decoder*) decoder;
+    assert(object);
+    return object->partitioning().blocks();
+}
+
+uint32_t kodoc_object_decoder_block_symbols(
+    kodoc_object_decoder_t decoder, uint32_t block)
+{
+    auto object = (kodoc::object_decoder*) decoder;
+    assert(object);
+    return object->partitioning().symbols(block);
+}
+
+uint32_t kodoc_object_decoder_payload_size(kodoc_object_decoder_t decoder)
+{
+    auto object = (kodoc::object_decoder*) decoder;
+    assert(object);
+    return object->payload_size();
+}
+
+kodoc_coder_t kodoc_object_decoder_coder(
+    kodoc_object_decoder_t decoder, uint32_t block)
+{
+    auto object = (kodoc::object_decoder*) decoder;
+    assert(object);
+    return object->coder(block);
+}
+
+uint32_t kodoc_object_decoder_read_payload(
+    kodoc_object_decoder_t decoder, uint8_t* payload)
+{
+    auto object = (kodoc::object_decoder*) decoder;
+    assert(object);
+    return object->read_payload(payload);
+}
+
+uint8_t kodoc_object_decoder_is_block_complete(
+    kodoc_object_decoder_t decoder, uint32_t block)
+{
+    auto object = (kodoc::object_decoder*) decoder;
+    assert(object);
+    assert(block < object->partitioning().blocks());
+    return object->is_block_complete(block);
+}
+
+uint8_t kodoc_object_decoder_is_complete(kodoc_object_decoder_t decoder)
+{
+    auto object = (kodoc::object_decoder*) decoder;
+    assert(object);
+    return object->is_complete();
+}
@@ -0,0 +1,97 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "kodoc.h"
+
+#include <cstdint>
+
+#include "allocator.hpp"
+#include "coder_pool.hpp"
+#include "partitioning.hpp"
+
+namespace kodoc
+{
+/// Decodes an object that was encoded with an object_encoder. The decoder
+/// of a block is taken from a coder pool when the first payload of the
+/// block arrives, and it is returned to the pool as soon as the block is
+/// complete.
+class object_decoder
+{
+public:
+
+    /// @param factory The decoder factory used to build the block decoders.
+    ///        The factory must outlive the object decoder.
+    /// @param data The buffer where the object is decoded
+    /// @param size The size of the object in bytes
+    object_decoder(kodoc_factory_t factory, uint8_t* data, uint64_t size);
+
+    ~object_decoder();
+
+    object_decoder(const object_decoder&) = delete;
+    object_decoder& operator=(const object_decoder&) = delete;
+
+    /// @return The partitioning of the object
+    const kodoc::partitioning& partitioning() const
+    {
+        return m_partitioning;
+    }
+
+    /// @return The maximum size of a block payload including the header
+    uint32_t payload_size() const;
+
+    /// @param block The block index
+    /// @return The decoder of the block, or a null pointer if the block is
+    ///         already complete
+    kodoc_coder_t coder(uint32_t block);
+
+    /// Reads a payload and passes it to the decoder of its block.
+    /// Payloads for unknown or complete blocks are ignored.
+    /// @return The block index of the payload
+    uint32_t read_payload(uint8_t* payload);
+
+    /// @return true if the given block is fully decoded
+    bool is_block_complete(uint32_t block) const
+    {
+        return m_complete[block] != 0;
+    }
+
+    /// @return true if the entire object is decoded
+    bool is_complete() const
+    {
+        return m_completed_blocks == m_partitioning.blocks();
+    }
+
+    /// @return The number of fully decoded blocks
+    uint32_t completed_blocks() const
+    {
+        return m_completed_blocks;
+    }
+
+private:
+
+    void complete_block(uint32_t block);
+
+private:
+
+    kodoc_factory_t m_factory;
+    kodoc::partitioning m_partitioning;
+    uint8_t* m_data;
+
+    /// The decoders of complete blocks are recycled for the next blocks
+    coder_pool m_pool;
+
+    /// The block decoders, a null entry means that it is not yet built or
+    /// that the block is complete
+    hook_vector<kodoc_coder_t> m_coders;
+
+    hook_vector<uint8_t> m_complete;
+    uint32_t m_completed_blocks;
+
+    /// Zero padded buffer for the last block if it contains a partial symbol
+    hook_vector<uint8_t> m_last_block;
+};
+}
@@ -0,0 +1,224 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include "object_encoder.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
+#include "block_header.hpp"
+#include "factory_cache.hpp"
+
+namespace kodoc
+{
+object_encoder::object_encoder(
+    kodoc_factory_t factory, uint8_t* data, uint64_t size) :
+    m_factory(factory),
+    m_partitioning(kodoc_factory_max_symbols(factory),
+                   kodoc_factory_max_symbol_size(factory), size),
+    m_data(data),
+    m_coders(m_partitioning.blocks(), nullptr,
+             hook_allocator<kodoc_coder_t>(factory_allocator(factory))),
+    m_systematic_index(m_partitioning.blocks(), 0, m_coders.get_allocator()),
+    m_last_block(m_coders.get_allocator())
+{
+    assert(m_factory);
+    assert(m_data);
+
+    uint32_t last = m_partitioning.blocks() - 1;
+    uint32_t last_bytes = m_partitioning.bytes(last);
+
+    // The coders require full symbols, so the last block is copied to a
+    // zero padded buffer if the object does not fill its last symbol
+    if (last_bytes < m_partitioning.block_size(last))
+    {
+        m_last_block.resize(m_partitioning.block_size(last), 0);
+        memcpy(m_last_block.data(), m_data + m_partitioning.offset(last),
+               last_bytes);
+    }
+}
+
+object_encoder::~object_encoder()
+{
+    for (auto coder : m_coders)
+    {
+        if (coder != nullptr)
+            kodoc_delete_coder(coder);
+    }
+}
+
+uint32_t object_encoder::payload_size() const
+{
+    return max_object_payload_size(m_factory);
+}
+
+kodoc_coder_t object_encoder::coder(uint32_t block)
+{
+    assert(block < m_coders.size());
+
+    if (m_coders[block] != nullptr)
+        return m_coders[block];
+
+    kodoc_coder_t encoder = build_coder(
+        m_factory, m_partitioning.symbols(block),
+        m_partitioning.symbol_size(), nullptr);
+
+    kodoc_set_const_symbols(encoder, block_data(block),
+                            m_partitioning.block_size(block));
+
+    m_coders[block] = encoder;
+    return encoder;
+}
+
+uint32_t object_encoder::write_payload(uint32_t block, uint8_t* payload)
+{
+    assert(payload);
+
+    kodoc_coder_t encoder = coder(block);
+
+    if (next_is_uncoded(block, encoder))
+    {
+        const uint8_t* symbol = write_uncoded_header(block, payload);
+        uint32_t symbol_size = m_partitioning.symbol_size();
+
+        memcpy(payload + uncoded_header_size, symbol, symbol_size);
+        return uncoded_header_size + symbol_size;
+    }
+
+    write_block_header(payload, block);
+    return block_header_size +
+           kodoc_write_payload(encoder, payload + block_header_size);
+}
+
+uint32_t object_encoder::write_payload_iov(
+    uint32_t block, uint8_t* payload, kodoc_iovec_t* iov)
+{
+    assert(payload);
+    assert(iov);
+
+    kodoc_coder_t encoder = coder(block);
+
+    if (next_is_uncoded(block, encoder))
+    {
+        const uint8_t* symbol = write_uncoded_header(block, payload);
+
+        iov[0].data = payload;
+        iov[0].size = uncoded_header_size;
+        iov[1].data = symbol;
+        iov[1].size = m_partitioning.symbol_size();
+        return 2;
+    }
+
+    write_block_header(payload, block);
+
+    iov[0].data = payload;
+    iov[0].size = block_header_size +
+        kodoc_write_payload(encoder, payload + block_header_size);
+    return 1;
+}
+
+uint8_t* object_encoder::block_data(uint32_t block)
+{
+    if (block + 1 == m_partitioning.blocks() && !m_last_block.empty())
+        return m_last_block.data();
+
+    return m_data + m_partitioning.offset(block);
+}
+
+bool object_encoder::next_is_uncoded(uint32_t block, kodoc_coder_t encoder)
+{
+    if (!kodoc_has_systematic_interface(encoder) ||
+        !kodoc_is_systematic_on(encoder))
+    {
+        return false;
+    }
+
+    if (m_systematic_index[block] < m_partitioning.symbols(block))
+        return true;
+
+    // All source symbols are sent, so the block encoder should only produce
+    // coded symbols from now on
+    kodoc_set_systematic_off(encoder);
+    return false;
+}
+
+const uint8_t* object_encoder::write_uncoded_header(
+    uint32_t block, uint8_t* payload)
+{
+    uint32_t index = m_systematic_index[block]++;
+    kodoc::write_uncoded_header(payload, block, index);
+
+    return block_data(block) + index * m_partitioning.symbol_size();
+}
+}
+
+//------------------------------------------------------------------
+// OBJECT ENCODER API
+//------------------------------------------------------------------
+
+kodoc_object_encoder_t kodoc_new_object_encoder(
+    kodoc_factory_t factory, uint8_t* data, uint64_t size)
+{
+    assert(factory);
+    assert(data);
+    assert(size > 0);
+    return (kodoc_object_encoder_t) new kodoc::object_encoder(
+        factory, data, size);
+}
+
+void kodoc_delete_object_encoder(kodoc_object_encoder_t encoder)
+{
+    auto object = (kodoc::object_encoder*) encoder;
+    assert(object);
+    delete object;
+}
+
+uint32_t kodoc_object_encoder_blocks(kodoc_object_encoder_t encoder)
+{
+    auto object = (kodoc::object_encoder*) encoder;
+    assert(object);
+    return object->partitioning().blocks();
+}
+
+uint32_t kodoc_object_encoder_block_symbols(
+    kodoc_object_encoder_t encoder, uint32_t block)
+{
+    auto object = (kodoc::object_encoder*) encoder;
+    assert(object);
+    return object->partitioning().symbols(block);
+}
+
+uint32_t kodoc_object_encoder_payload_size(kodoc_object_encoder_t encoder)
+{
+    auto object = (kodoc::object_encoder*) encoder;
+    assert(object);
+    return object->payload_size();
+}
+
+kodoc_coder_t kodoc_object_encoder_coder(
+    kodoc_object_encoder_t encoder, uint32_t block)
+{
+    auto object = (kodoc::object_encoder*) encoder;
+    assert(object);
+    return object->coder(block);
+}
+
+uint32_t kodoc_object_encoder_write_payload(
+    kodoc_object_encoder_t encoder, uint32_t block, uint8_t* payload)
+{
+    auto object = (kodoc::object_encoder*) encoder;
+    assert(object);
+    return object->write_payload(block, payload);
+}
+
+uint32_t kodoc_object_encoder_write_payload_iov(
+    kodoc_object_encoder_t encoder, uint32_t block, uint8_t* payload,
+    kodoc_iovec_t* iov)
+{
+    auto object = (kodoc::object_encoder*) encoder;
+    assert(object);
+    return object->write_payload_iov(block, payload, iov);
+}
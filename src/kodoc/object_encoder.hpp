@@ -0,0 +1,93 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "kodoc.h"
+
+#include <cstdint>
+
+#include "allocator.hpp"
+#include "partitioning.hpp"
+
+namespace kodoc
+{
+/// Encodes an object of arbitrary size by splitting it into blocks that are
+/// encoded independently. The encoder of a block is built on first use
+/// with the factory that was passed to the constructor.
+class object_encoder
+{
+public:
+
+    /// @param factory The encoder factory used to build the block encoders.
+    ///        The factory must outlive the object encoder.
+    /// @param data The object data. The data is not copied, so the buffer
+    ///        must outlive the object encoder.
+    /// @param size The size of the object in bytes
+    object_encoder(kodoc_factory_t factory, uint8_t* data, uint64_t size);
+
+    ~object_encoder();
+
+    object_encoder(const object_encoder&) = delete;
+    object_encoder& operator=(const object_encoder&) = delete;
+
+    /// @return The partitioning of the object
+    const kodoc::partitioning& partitioning() const
+    {
+        return m_partitioning;
+    }
+
+    /// @return The maximum size of a block payload including the header
+    uint32_t payload_size() const;
+
+    /// @param block The block index
+    /// @return The encoder of the block, which is built if needed
+    kodoc_coder_t coder(uint32_t block);
+
+    /// Writes a payload for the given block
+    /// @return The total bytes used from the payload buffer
+    uint32_t write_payload(uint32_t block, uint8_t* payload);
+
+    /// Writes a payload for the given block as a list of buffers. A coded
+    /// payload is written to the payload buffer, and it is the only entry.
+    /// For an uncoded symbol, only the header is written to the payload
+    /// buffer, and the second entry points to the symbol in the object.
+    /// @param iov The array of buffers, which must have room for 2 entries
+    /// @return The number of entries used in iov
+    uint32_t write_payload_iov(uint32_t block, uint8_t* payload,
+                               kodoc_iovec_t* iov);
+
+private:
+
+    /// @return The data of the block as seen by its encoder
+    uint8_t* block_data(uint32_t block);
+
+    /// Checks whether the next payload of the block should be an uncoded
+    /// symbol. The object encoder sends the source symbols itself while the
+    /// systematic mode of the block encoder is on, and it switches the
+    /// systematic mode off when all source symbols have been sent.
+    /// @return true if the next payload is an uncoded symbol
+    bool next_is_uncoded(uint32_t block, kodoc_coder_t encoder);
+
+    /// Writes the uncoded header for the next source symbol of the block
+    /// @return The source symbol that follows the header
+    const uint8_t* write_uncoded_header(uint32_t block, uint8_t* payload);
+
+private:
+
+    kodoc_factory_t m_factory;
+    kodoc::partitioning m_partitioning;
+    uint8_t* m_data;
+
+    /// The block encoders, a null entry means that it is not yet built
+    hook_vector<kodoc_coder_t> m_coders;
+
+    /// The index of the next source symbol to send for every block
+    hook_vector<uint32_t> m_systematic_index;
+
+    /// Zero padded copy of the last block if it contains a partial symbol
+    hook_vector<uint8_t> m_last_block;
+};
+}
@@ -0,0 +1,327 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include "parallel_decoder.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
+#include "block_header.hpp"
+#include "thread_affinity.hpp"
+
+namespace kodoc
+{
+parallel_decoder::parallel_decoder(
+    kodoc_factory_t factory, uint8_t* data, uint64_t size, uint32_t threads,
+    const uint32_t* cpus, kodoc_block_callback_t callback, void* context) :
+    m_factory(factory),
+    m_partitioning(kodoc_factory_max_symbols(factory),
+                   kodoc_factory_max_symbol_size(factory), size),
+    m_data(data),
+    m_payload_size(max_object_payload_size(factory)),
+    m_callback(callback),
+    m_context(context),
+    m_coders(m_partitioning.blocks(), nullptr,
+             hook_allocator<kodoc_coder_t>(factory_allocator(factory))),
+    m_complete(new std::atomic<uint8_t>[m_partitioning.blocks()]),
+    m_completed_blocks(0),
+    m_last_block(m_coders.get_allocator()),
+    m_pool(factory),
+    m_stop(false)
+{
+    assert(m_factory);
+    assert(m_data);
+
+    for (uint32_t i = 0; i < m_partitioning.blocks(); ++i)
+        m_complete[i] = 0;
+
+    uint32_t last = m_partitioning.blocks() - 1;
+    if (m_partitioning.bytes(last) < m_partitioning.block_size(last))
+    {
+        m_last_block.resize(m_partitioning.block_size(last), 0);
+    }
+
+    if (threads == 0)
+        threads = std::thread::hardware_concurrency();
+
+    if (threads == 0)
+        threads = 1;
+
+    for (uint32_t i = 0; i < threads; ++i)
+        m_workers.emplace_back(new worker());
+
+    // The cores are passed by value, since the workers may start after
+    // the caller's array is gone
+    for (uint32_t i = 0; i < threads; ++i)
+    {
+        m_workers[i]->m_thread = std::thread(
+            &parallel_decoder::run, this, i, cpus != nullptr,
+            cpus ? cpus[i] : 0);
+    }
+}
+
+parallel_decoder::~parallel_decoder()
+{
+    m_stop = true;
+
+    for (auto& w : m_workers)
+    {
+        // Taking the lock ensures that the worker is either waiting or will
+        // see the stop flag before it waits
+        {
+            std::lock_guard<std::mutex> lock(w->m_mutex);
+        }
+        w->m_wakeup.notify_all();
+    }
+
+    for (auto& w : m_workers)
+        w->m_thread.join();
+
+    for (auto coder : m_coders)
+    {
+        if (coder != nullptr)
+            m_pool.release(coder);
+    }
+}
+
+void parallel_decoder::read_payload(const uint8_t* payload, uint32_t size)
+{
+    assert(payload);
+
+    // A datagram may be truncated or malformed, so payloads that cannot
+    // hold a symbol are dropped
+    uint32_t symbol_size = m_partitioning.symbol_size();
+    if (size < block_header_size + symbol_size)
+        return;
+
+    if (is_uncoded_symbol(payload) &&
+        size < uncoded_header_size + symbol_size)
+    {
+        return;
+    }
+
+    uint32_t block = read_block_header(payload);
+
+    if (block >= m_partitioning.blocks() || m_complete[block])
+        return;
+
+    auto& w = *m_workers[block % m_workers.size()];
+    {
+        std::lock_guard<std::mutex> lock(w.m_mutex);
+
+        std::vector<uint8_t> buffer;
+        if (!w.m_free.empty())
+        {
+            buffer = std::move(w.m_free.back());
+            w.m_free.pop_back();
+        }
+
+        // The size of a coded payload is checked by the worker, since
+        // the payload size of the block decoder is only known there
+        buffer.assign(payload, payload + size);
+
+        w.m_queue.push_back(std::move(buffer));
+    }
+    w.m_wakeup.notify_one();
+}
+
+void parallel_decoder::wait()
+{
+    std::unique_lock<std::mutex> lock(m_completion_mutex);
+    m_completion.wait(lock, [this] { return is_complete(); });
+}
+
+void parallel_decoder::run(uint32_t index, bool pin, uint32_t cpu)
+{
+    if (pin)
+        pin_current_thread(cpu);
+
+    auto& w = *m_workers[index];
+    std::deque<std::vector<uint8_t>> batch;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(w.m_mutex);
+
+            // Return the buffers of the previous batch for reuse
+            for (auto& buffer : batch)
+                w.m_free.push_back(std::move(buffer));
+            batch.clear();
+
+            w.m_wakeup.wait(lock, [this, &w]
+            {
+                return m_stop || !w.m_queue.empty();
+            });
+
+            if (m_stop)
+                return;
+
+            // Take all queued payloads, so the producer is not blocked
+            // while they are decoded
+            batch.swap(w.m_queue);
+        }
+
+        for (auto& buffer : batch)
+            decode(buffer.data(), (uint32_t) buffer.size());
+    }
+}
+
+void parallel_decoder::decode(uint8_t* payload, uint32_t size)
+{
+    uint32_t block = read_block_header(payload);
+
+    if (m_complete[block])
+        return;
+
+    kodoc_coder_t decoder = m_coders[block];
+    if (decoder == nullptr)
+        decoder = build_decoder(block);
+
+    // A coded payload that is truncated inside the coding coefficients or
+    // the seed would be decoded with a wrong equation, so it is dropped
+    if (!is_uncoded_symbol(payload) &&
+        size < block_header_size + kodoc_payload_size(decoder))
+    {
+        return;
+    }
+
+    read_block_payload(decoder, payload);
+
+    if (kodoc_is_complete(decoder))
+        complete_block(block);
+}
+
+kodoc_coder_t parallel_decoder::build_decoder(uint32_t block)
+{
+    kodoc_coder_t decoder;
+    {
+        std::lock_guard<std::mutex> lock(m_pool_mutex);
+        decoder = m_pool.acquire(
+            m_partitioning.symbols(block), m_partitioning.symbol_size());
+    }
+
+    uint32_t block_size = m_partitioning.block_size(block);
+    uint8_t* block_data = m_data + m_partitioning.offset(block);
+
+    if (block + 1 == m_partitioning.blocks() && !m_last_block.empty())
+        block_data = m_last_block.data();
+
+    kodoc_set_mutable_symbols(decoder, block_data, block_size);
+
+    m_coders[block] = decoder;
+    return decoder;
+}
+
+void parallel_decoder::complete_block(uint32_t block)
+{
+    uint8_t* block_data = m_data + m_partitioning.offset(block);
+    uint32_t bytes = m_partitioning.bytes(block);
+
+    if (block + 1 == m_partitioning.blocks() && !m_last_block.empty())
+        memcpy(block_data, m_last_block.data(), bytes);
+
+    {
+        std::lock_guard<std::mutex> lock(m_pool_mutex);
+        m_pool.release(m_coders[block]);
+    }
+    m_coders[block] = nullptr;
+
+    m_complete[block] = 1;
+
+    if (m_callback != nullptr)
+        m_callback(block, block_data, bytes, m_context);
+
+    {
+        std::lock_guard<std::mutex> lock(m_completion_mutex);
+        ++m_completed_blocks;
+    }
+    m_completion.notify_all();
+}
+}
+
+//------------------------------------------------------------------
+// PARALLEL DECODER API
+//------------------------------------------------------------------
+
+kodoc_parallel_decoder_t kodoc_new_parallel_decoder(
+    kodoc_factory_t factory, uint8_t* data, uint64_t size, uint32_t threads,
+    const uint32_t* cpus, kodoc_block_callback_t callback, void* context)
+{
+    assert(factory);
+    assert(data);
+    assert(size > 0);
+    return (kodoc_parallel_decoder_t) new kodoc::parallel_decoder(
+        factory, data, size, threads, cpus, callback, context);
+}
+
+void kodoc_delete_parallel_decoder(kodoc_parallel_decoder_t decoder)
+{
+    auto parallel = (kodoc::parallel_decoder*) decoder;
+    assert(parallel);
+    delete parallel;
+}
+
+uint32_t kodoc_parallel_decoder_blocks(kodoc_parallel_decoder_t decoder)
+{
+    auto parallel = (kodoc::parallel_decoder*) decoder;
+    assert(parallel);
+    return parallel->partitioning().blocks();
+}
+
+uint32_t kodoc_parallel_decoder_threads(kodoc_parallel_decoder_t decoder)
+{
+    auto parallel = (kodoc::parallel_decoder*) decoder;
+    assert(parallel);
+    return parallel->threads();
+}
+
+uint32_t kodoc_parallel_decoder_payload_size(
+    kodoc_parallel_decoder_t decoder)
+{
+    auto parallel = (kodoc::parallel_decoder*) decoder;
+    assert(parallel);
+    return parallel->payload_size();
+}
+
+void kodoc_parallel_decoder_read_payload(
+    kodoc_parallel_decoder_t decoder, const uint8_t* payload, uint32_t size)
+{
+    auto parallel = (kodoc::parallel_decoder*) decoder;
+    assert(parallel);
+    parallel->read_payload(payload, size);
+}
+
+uint8_t kodoc_parallel_decoder_is_block_complete(
+    kodoc_parallel_decoder_t decoder, uint32_t block)
+{
+    auto parallel = (kodoc::parallel_decoder*) decoder;
+    assert(parallel);
+    assert(block < parallel->partitioning().blocks());
+    return parallel->is_block_complete(block);
+}
+
+uint32_t kodoc_parallel_decoder_completed_blocks(
+    kodoc_parallel_decoder_t decoder)
+{
+    auto parallel = (kodoc::parallel_decoder*) decoder;
+    assert(parallel);
+    return parallel->completed_blocks();
+}
+
+uint8_t kodoc_parallel_decoder_is_complete(kodoc_parallel_decoder_t decoder)
+{
+    auto parallel = (kodoc::parallel_decoder*) decoder;
+    assert(parallel);
+    return parallel->is_complete();
+}
+
+void kodoc_parallel_decoder_wait(kodoc_parallel_decoder_t decoder)
+{
+    auto parallel = (kodoc::parallel_decoder*) decoder;
+    assert(parallel);
+    parallel->wait();
+}
@@ -0,0 +1,153 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "kodoc.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "allocator.hpp"
+#include "coder_pool.hpp"
+#include "partitioning.hpp"
+
+namespace kodoc
+{
+/// Decodes the blocks of an object on a set of worker threads. Incoming
+/// payloads are routed by their block id, and every block is owned by a
+/// single worker (block % threads), so a block decoder is only ever used
+/// by one thread. A user callback is invoked when a block is complete.
+class parallel_decoder
+{
+public:
+
+    /// @param factory The decoder factory used to build the block decoders
+    /// @param data The buffer where the object is decoded
+    /// @param size The size of the object in bytes
+    /// @param threads The number of worker threads (0 for one per core)
+    /// @param cpus Optional array of CPU cores that the workers are pinned to
+    /// @param callback Optional callback for completed blocks
+    /// @param context Pointer forwarded to the callback
+    parallel_decoder(kodoc_factory_t factory, uint8_t* data, uint64_t size,
+                     uint32_t threads, const uint32_t* cpus,
+                     kodoc_block_callback_t callback, void* context);
+
+    /// Stops the workers. Payloads that are still queued are discarded.
+    ~parallel_decoder();
+
+    parallel_decoder(const parallel_decoder&) = delete;
+    parallel_decoder& operator=(const parallel_decoder&) = delete;
+
+    /// @return The partitioning of the object
+    const kodoc::partitioning& partitioning() const
+    {
+        return m_partitioning;
+    }
+
+    /// @return The maximum size of a block payload including the header
+    uint32_t payload_size() const
+    {
+        return m_payload_size;
+    }
+
+    /// @return The number of worker threads
+    uint32_t threads() const
+    {
+        return (uint32_t) m_workers.size();
+    }
+
+    /// Copies the payload to the queue of the worker that owns its block.
+    /// Payloads for unknown or complete blocks, and payloads that are too
+    /// short to hold a symbol, are dropped.
+    void read_payload(const uint8_t* payload, uint32_t size);
+
+    /// @return The number of fully decoded blocks
+    uint32_t completed_blocks() const
+    {
+        return m_completed_blocks;
+    }
+
+    /// @return true if the given block is fully decoded
+    bool is_block_complete(uint32_t block) const
+    {
+        return m_complete[block] != 0;
+    }
+
+    /// @return true if all blocks are fully decoded
+    bool is_complete() const
+    {
+        return m_completed_blocks == m_partitioning.blocks();
+    }
+
+    /// Blocks until all blocks are fully decoded
+    void wait();
+
+private:
+
+    struct worker
+    {
+        std::thread m_thread;
+        std::mutex m_mutex;
+        std::condition_variable m_wakeup;
+
+        /// Payloads waiting to be decoded
+        std::deque<std::vector<uint8_t>> m_queue;
+
+        /// Payload buffers that can be reused
+        std::vector<std::vector<uint8_t>> m_free;
+    };
+
+    /// Runs a worker, which is pinned to the given core if pin is true
+    void run(uint32_t index, bool pin, uint32_t cpu);
+
+    void decode(uint8_t* payload, uint32_t size);
+
+    kodoc_coder_t build_decoder(uint32_t block);
+
+    void complete_block(uint32_t block);
+
+private:
+
+    kodoc_factory_t m_factory;
+    kodoc::partitioning m_partitioning;
+    uint8_t* m_data;
+
+    /// The maximum payload size of the object
+    uint32_t m_payload_size;
+
+    kodoc_block_callback_t m_callback;
+    void* m_context;
+
+    /// The block decoders, only accessed by the owning worker
+    hook_vector<kodoc_coder_t> m_coders;
+
+    /// Completion flags that are also read by the producer thread
+    std::unique_ptr<std::atomic<uint8_t>[]> m_complete;
+    std::atomic<uint32_t> m_completed_blocks;
+
+    /// Zero padded buffer for the last block if it contains a partial symbol
+    hook_vector<uint8_t> m_last_block;
+
+    /// Serializes the use of the pool between the workers. The factory
+    /// itself is set up and used in one step by the pool, see build_coder().
+    std::mutex m_pool_mutex;
+
+    /// The decoders of complete blocks are recycled for the next blocks
+    coder_pool m_pool;
+
+    std::mutex m_completion_mutex;
+    std::condition_variable m_completion;
+
+    std::atomic<bool> m_stop;
+    std::vector<std::unique_ptr<worker>> m_workers;
+};
+}
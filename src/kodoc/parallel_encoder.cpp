@@ -0,0 +1,153 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include "parallel_encoder.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
+namespace kodoc
+{
+parallel_encoder::parallel_encoder(
+    kodoc_factory_t factory, uint8_t* data, uint64_t size,
+    uint32_t ring_size, uint32_t threads, const uint32_t* cpus) :
+    m_object(factory, data, size),
+    m_pool(threads, cpus)
+{
+    assert(ring_size > 0);
+
+    uint32_t blocks = m_object.partitioning().blocks();
+    kodoc_allocator_t allocator = factory_allocator(factory);
+
+    // All encoders are built up front on the calling thread, since the
+    // factory cannot be used concurrently by the workers
+    for (uint32_t i = 0; i < blocks; ++i)
+    {
+        m_object.coder(i);
+        m_generations.emplace_back(
+            new generation(ring_size, m_object.payload_size(), allocator));
+    }
+
+    for (uint32_t i = 0; i < blocks; ++i)
+    {
+        std::lock_guard<std::mutex> lock(m_generations[i]->m_mutex);
+        schedule(i);
+    }
+}
+
+uint32_t parallel_encoder::write_payload(uint32_t block, uint8_t* payload)
+{
+    assert(block < m_generations.size());
+    assert(payload);
+
+    auto& g = *m_generations[block];
+    std::unique_lock<std::mutex> lock(g.m_mutex);
+
+    g.m_ready.wait(lock, [&g] { return !g.m_ring.empty(); });
+
+    uint32_t bytes_used = g.m_ring.front_size();
+    memcpy(payload, g.m_ring.front(), bytes_used);
+    g.m_ring.pop();
+
+    if (!g.m_scheduled)
+        schedule(block);
+
+    return bytes_used;
+}
+
+void parallel_encoder::schedule(uint32_t block)
+{
+    auto& g = *m_generations[block];
+    assert(!g.m_scheduled);
+
+    g.m_scheduled = true;
+    m_pool.submit([this, block] { refill(block); });
+}
+
+void parallel_encoder::refill(uint32_t block)
+{
+    auto& g = *m_generations[block];
+
+    while (true)
+    {
+        uint8_t* slot;
+        {
+            std::lock_guard<std::mutex> lock(g.m_mutex);
+
+            if (g.m_ring.full())
+            {
+                g.m_scheduled = false;
+                return;
+            }
+
+            // The free slot is not visible to the consumer until it is
+            // pushed, so it can be written without holding the lock
+            slot = g.m_ring.back();
+        }
+
+        uint32_t bytes_used = m_object.write_payload(block, slot);
+
+        {
+            std::lock_guard<std::mutex> lock(g.m_mutex);
+            g.m_ring.push(bytes_used);
+        }
+        g.m_ready.notify_one();
+    }
+}
+}
+
+//------------------------------------------------------------------
+// PARALLEL ENCODER API
+//------------------------------------------------------------------
+
+kodoc_parallel_encoder_t kodoc_new_parallel_encoder(
+    kodoc_factory_t factory, uint8_t* data, uint64_t size,
+    uint32_t ring_size, uint32_t threads, const uint32_t* cpus)
+{
+    assert(factory);
+    assert(data);
+    assert(size > 0);
+    assert(ring_size > 0);
+    return (kodoc_parallel_encoder_t) new kodoc::parallel_encoder(
+        factory, data, size, ring_size, threads, cpus);
+}
+
+void kodoc_delete_parallel_encoder(kodoc_parallel_encoder_t encoder)
+{
+    auto parallel = (kodoc::parallel_encoder*) encoder;
+    assert(parallel);
+    delete parallel;
+}
+
+uint32_t kodoc_parallel_encoder_blocks(kodoc_parallel_encoder_t encoder)
+{
+    auto parallel = (kodoc::parallel_encoder*) encoder;
+    assert(parallel);
+    return parallel->partitioning().blocks();
+}
+
+uint32_t kodoc_parallel_encoder_threads(kodoc_parallel_encoder_t encoder)
+{
+    auto parallel = (kodoc::parallel_encoder*) encoder;
+    assert(parallel);
+    return parallel->threads();
+}
+
+uint32_t kodoc_parallel_encoder_payload_size(
+    kodoc_parallel_encoder_t encoder)
+{
+    auto parallel = (kodoc::parallel_encoder*) encoder;
+    assert(parallel);
+    return parallel->payload_size();
+}
+
+uint32_t kodoc_parallel_encoder_write_payload(
+    kodoc_parallel_encoder_t encoder, uint32_t block, uint8_t* payload)
+{
+    auto parallel = (kodoc::parallel_encoder*) encoder;
+    assert(parallel);
+    return parallel->write_payload(block, payload);
+}
@@ -0,0 +1,97 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "kodoc.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "object_encoder.hpp"
+#include "payload_ring.hpp"
+#include "work_stealing_pool.hpp"
+
+namespace kodoc
+{
+/// Encodes the blocks of an object in parallel. Every block has a ring of
+/// ready payloads that is refilled on a work_stealing_pool whenever the
+/// consumer takes a payload from it.
+class parallel_encoder
+{
+public:
+
+    /// @param factory The encoder factory used to build the block encoders
+    /// @param data The object data, which must outlive the encoder
+    /// @param size The size of the object in bytes
+    /// @param ring_size The number of payloads buffered for every block
+    /// @param threads The number of worker threads (0 for one per core)
+    /// @param cpus Optional array of CPU cores that the workers are pinned to
+    parallel_encoder(kodoc_factory_t factory, uint8_t* data, uint64_t size,
+                     uint32_t ring_size, uint32_t threads,
+                     const uint32_t* cpus);
+
+    /// @return The partitioning of the object
+    const kodoc::partitioning& partitioning() const
+    {
+        return m_object.partitioning();
+    }
+
+    /// @return The maximum size of a block payload including the header
+    uint32_t payload_size() const
+    {
+        return m_object.payload_size();
+    }
+
+    /// @return The number of worker threads
+    uint32_t threads() const
+    {
+        return m_pool.threads();
+    }
+
+    /// Copies the next ready payload of a block into the payload buffer.
+    /// If no payload is ready, the call blocks until a worker produced one.
+    /// @return The total bytes used from the payload buffer
+    uint32_t write_payload(uint32_t block, uint8_t* payload);
+
+private:
+
+    struct generation
+    {
+        generation(uint32_t ring_size, uint32_t payload_size,
+                   const kodoc_allocator_t& allocator) :
+            m_ring(ring_size, payload_size, allocator),
+            m_scheduled(false)
+        { }
+
+        std::mutex m_mutex;
+        std::condition_variable m_ready;
+        payload_ring m_ring;
+
+        /// True while a refill task for the generation is queued or running
+        bool m_scheduled;
+    };
+
+    /// Queues a refill task for the block. The caller must hold the mutex
+    /// of the generation.
+    void schedule(uint32_t block);
+
+    /// Fills the ring of the block. Only one refill task per block is active
+    /// at any time, so the block encoder is never used concurrently.
+    void refill(uint32_t block);
+
+private:
+
+    object_encoder m_object;
+    std::vector<std::unique_ptr<generation>> m_generations;
+
+    /// The pool is declared last so that the workers are stopped before
+    /// the generations and the coders are destroyed
+    work_stealing_pool m_pool;
+};
+}
@@ -0,0 +1,114 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+namespace kodoc
+{
+/// Splits an object into blocks (generations) of almost equal size.
+///
+/// The scheme follows the block partitioning algorithm of RFC 5052:
+/// the object is first divided into symbols of a fixed size, and then the
+/// smallest possible number of blocks is chosen such that no block has more
+/// than max_symbols symbols. The symbols are spread evenly, so the number
+/// of symbols in two blocks differs by at most one. This keeps every
+/// generation as large as allowed (low relative coding overhead) without
+/// producing a small trailing generation that would be expensive to
+/// complete, and without exceeding the decoding complexity of max_symbols.
+class partitioning
+{
+public:
+
+    /// @param max_symbols The maximum number of symbols in a block
+    /// @param symbol_size The size of a symbol in bytes
+    /// @param object_size The size of the object in bytes
+    partitioning(uint32_t max_symbols, uint32_t symbol_size,
+                 uint64_t object_size) :
+        m_symbol_size(symbol_size),
+        m_object_size(object_size)
+    {
+        assert(max_symbols > 0);
+        assert(symbol_size > 0);
+        assert(object_size > 0);
+
+        uint64_t total_symbols =
+            (object_size + symbol_size - 1) / symbol_size;
+
+        uint64_t blocks = (total_symbols + max_symbols - 1) / max_symbols;
+        assert(blocks <= UINT32_MAX);
+        m_blocks = (uint32_t) blocks;
+
+        m_small_symbols = (uint32_t) (total_symbols / m_blocks);
+        m_large_blocks = (uint32_t) (total_symbols % m_blocks);
+    }
+
+    /// @return The number of blocks in the object
+    uint32_t blocks() const
+    {
+        return m_blocks;
+    }
+
+    /// @return The size of a symbol in bytes
+    uint32_t symbol_size() const
+    {
+        return m_symbol_size;
+    }
+
+    /// @return The size of the object in bytes
+    uint64_t object_size() const
+    {
+        return m_object_size;
+    }
+
+    /// @param block The block index
+    /// @return The number of symbols in the block
+    uint32_t symbols(uint32_t block) const
+    {
+        assert(block < m_blocks);
+        return block < m_large_blocks ? m_small_symbols + 1 : m_small_symbols;
+    }
+
+    /// @param block The block index
+    /// @return The size of the block in bytes when all symbols are full
+    uint32_t block_size(uint32_t block) const
+    {
+        return symbols(block) * m_symbol_size;
+    }
+
+    /// @param block The block index
+    /// @return The offset of the first byte of the block in the object
+    uint64_t offset(uint32_t block) const
+    {
+        assert(block < m_blocks);
+
+        uint64_t symbols_before = (uint64_t) block * m_small_symbols;
+        symbols_before += block < m_large_blocks ? block : m_large_blocks;
+
+        return symbols_before * m_symbol_size;
+    }
+
+    /// @param block The block index
+    /// @return The number of object bytes stored in the block. This is
+    ///         only less than block_size() for the last block.
+    uint32_t bytes(uint32_t block) const
+    {
+        uint64_t remaining = m_object_size - offset(block);
+        uint64_t size = block_size(block);
+
+        return (uint32_t) (remaining < size ? remaining : size);
+    }
+
+private:
+
+    uint32_t m_symbol_size;
+    uint64_t m_object_size;
+    uint32_t m_blocks;
+    uint32_t m_small_symbols;
+    uint32_t m_large_blocks;
+};
+}
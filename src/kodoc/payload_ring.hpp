@@ -0,0 +1,112 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "kodoc.h"
+
+#include <cassert>
+#include <cstdint>
+
+#include "allocator.hpp"
+
+namespace kodoc
+{
+/// Fixed capacity ring of payload buffers. All slots are allocated up
+/// front. The producer writes into back() and then calls push(), the
+/// consumer reads front() and then calls pop(). The ring itself is not
+/// synchronized.
+class payload_ring
+{
+public:
+
+    payload_ring(uint32_t capacity, uint32_t payload_size,
+                 const kodoc_allocator_t& allocator = default_allocator()) :
+        m_payload_size(payload_size),
+        m_buffer(capacity * payload_size, 0,
+                 hook_allocator<uint8_t>(allocator)),
+        m_sizes(capacity, 0, hook_allocator<uint32_t>(allocator)),
+        m_head(0),
+        m_count(0)
+    {
+        assert(capacity > 0);
+        assert(payload_size > 0);
+    }
+
+    uint32_t capacity() const
+    {
+        return (uint32_t) m_sizes.size();
+    }
+
+    uint32_t size() const
+    {
+        return m_count;
+    }
+
+    bool empty() const
+    {
+        return m_count == 0;
+    }
+
+    bool full() const
+    {
+        return m_count == capacity();
+    }
+
+    /// @return The buffer of the first free slot
+    uint8_t* back()
+    {
+        assert(!full());
+        return slot((m_head + m_count) % capacity());
+    }
+
+    /// Makes the first free slot available to the consumer
+    /// @param bytes_used The number of bytes used in the slot
+    void push(uint32_t bytes_used)
+    {
+        assert(!full());
+        assert(bytes_used <= m_payload_size);
+        m_sizes[(m_head + m_count) % capacity()] = bytes_used;
+        ++m_count;
+    }
+
+    /// @return The buffer of the oldest payload
+    const uint8_t* front() const
+    {
+        assert(!empty());
+        return &m_buffer[m_head * m_payload_size];
+    }
+
+    /// @return The bytes used in the oldest payload
+    uint32_t front_size() const
+    {
+        assert(!empty());
+        return m_sizes[m_head];
+    }
+
+    /// Releases the oldest payload
+    void pop()
+    {
+        assert(!empty());
+        m_head = (m_head + 1) % capacity();
+        --m_count;
+    }
+
+private:
+
+    uint8_t* slot(uint32_t index)
+    {
+        return &m_buffer[index * m_payload_size];
+    }
+
+private:
+
+    uint32_t m_payload_size;
+    hook_vector<uint8_t> m_buffer;
+    hook_vector<uint32_t> m_sizes;
+    uint32_t m_head;
+    uint32_t m_count;
+};
+}
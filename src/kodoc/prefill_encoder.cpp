@@ -0,0 +1,161 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include "prefill_encoder.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
+#include "thread_affinity.hpp"
+
+namespace kodoc
+{
+prefill_encoder::prefill_encoder(kodoc_coder_t encoder, uint32_t ring_size,
+                                 const uint32_t* cpu) :
+    m_encoder(encoder),
+    m_payload_size(kodoc_payload_size(encoder)),
+    m_ring(ring_size, m_payload_size),
+    m_stop(false),
+    m_worker(&prefill_encoder::run, this, cpu != nullptr,
+             cpu != nullptr ? *cpu : 0)
+{
+    assert(m_encoder);
+}
+
+prefill_encoder::~prefill_encoder()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_free.notify_one();
+
+    m_worker.join();
+}
+
+uint32_t prefill_encoder::ready()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_ring.size();
+}
+
+uint32_t prefill_encoder::write_payload(uint8_t* payload)
+{
+    assert(payload);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_ready.wait(lock, [this] { return !m_ring.empty(); });
+
+    uint32_t bytes_used = pop_payload(payload);
+    lock.unlock();
+
+    m_free.notify_one();
+    return bytes_used;
+}
+
+uint32_t prefill_encoder::try_write_payload(uint8_t* payload)
+{
+    assert(payload);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_ring.empty())
+        return 0;
+
+    uint32_t bytes_used = pop_payload(payload);
+    lock.unlock();
+
+    m_free.notify_one();
+    return bytes_used;
+}
+
+uint32_t prefill_encoder::pop_payload(uint8_t* payload)
+{
+    uint32_t bytes_used = m_ring.front_size();
+    memcpy(payload, m_ring.front(), bytes_used);
+    m_ring.pop();
+    return bytes_used;
+}
+
+void prefill_encoder::run(bool pin, uint32_t cpu)
+{
+    if (pin)
+        pin_current_thread(cpu);
+
+    while (true)
+    {
+        uint8_t* slot;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_free.wait(lock, [this] { return m_stop || !m_ring.full(); });
+
+            if (m_stop)
+                return;
+
+            // The free slot is not visible to the consumer until it is
+            // pushed, so it can be written without holding the lock
+            slot = m_ring.back();
+        }
+
+        uint32_t bytes_used = kodoc_write_payload(m_encoder, slot);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_ring.push(bytes_used);
+        }
+        m_ready.notify_one();
+    }
+}
+}
+
+//------------------------------------------------------------------
+// PREFILL ENCODER API
+//------------------------------------------------------------------
+
+kodoc_prefill_encoder_t kodoc_new_prefill_encoder(
+    kodoc_coder_t encoder, uint32_t ring_size, const uint32_t* cpu)
+{
+    assert(encoder);
+    assert(ring_size > 0);
+    return (kodoc_prefill_encoder_t) new kodoc::prefill_encoder(
+        encoder, ring_size, cpu);
+}
+
+void kodoc_delete_prefill_encoder(kodoc_prefill_encoder_t encoder)
+{
+    auto prefill = (kodoc::prefill_encoder*) encoder;
+    assert(prefill);
+    delete prefill;
+}
+
+uint32_t kodoc_prefill_encoder_payload_size(kodoc_prefill_encoder_t encoder)
+{
+    auto prefill = (kodoc::prefill_encoder*) encoder;
+    assert(prefill);
+    return prefill->payload_size();
+}
+
+uint32_t kodoc_prefill_encoder_ready(kodoc_prefill_encoder_t encoder)
+{
+    auto prefill = (kodoc::prefill_encoder*) encoder;
+    assert(prefill);
+    return prefill->ready();
+}
+
+uint32_t kodoc_prefill_encoder_write_payload(
+    kodoc_prefill_encoder_t encoder, uint8_t* payload)
+{
+    auto prefill = (kodoc::prefill_encoder*) encoder;
+    assert(prefill);
+    return prefill->write_payload(payload);
+}
+
+uint32_t kodoc_prefill_encoder_try_write_payload(
+    kodoc_prefill_encoder_t encoder, uint8_t* payload)
+{
+    auto prefill = (kodoc::prefill_encoder*) encoder;
+    assert(prefill);
+    return prefill->try_write_payload(payload);
+}
@@ -0,0 +1,87 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "kodoc.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#include "payload_ring.hpp"
+
+namespace kodoc
+{
+/// Precomputes the coded payloads of an encoder on a background thread.
+/// The worker keeps a ring of ready payloads full, so that the sender only
+/// copies a finished payload out of the ring.
+class prefill_encoder
+{
+public:
+
+    /// @param encoder The encoder that produces the payloads. The encoder
+    ///        is only used by the worker thread while the prefill encoder
+    ///        exists, and it must outlive the prefill encoder.
+    /// @param ring_size The number of ready payloads kept in the ring
+    /// @param cpu Optional CPU core that the worker is pinned to
+    prefill_encoder(kodoc_coder_t encoder, uint32_t ring_size,
+                    const uint32_t* cpu);
+
+    /// Stops and joins the worker thread
+    ~prefill_encoder();
+
+    prefill_encoder(const prefill_encoder&) = delete;
+    prefill_encoder& operator=(const prefill_encoder&) = delete;
+
+    /// @return The maximum size of a payload
+    uint32_t payload_size() const
+    {
+        return m_payload_size;
+    }
+
+    /// @return The number of payloads that are ready
+    uint32_t ready();
+
+    /// Copies the oldest ready payload into the payload buffer. If no
+    /// payload is ready, the call blocks until the worker produced one.
+    /// @return The bytes used from the payload buffer
+    uint32_t write_payload(uint8_t* payload);
+
+    /// Copies the oldest ready payload into the payload buffer, if any
+    /// @return The bytes used from the payload buffer, or 0 if no payload
+    ///         was ready
+    uint32_t try_write_payload(uint8_t* payload);
+
+private:
+
+    /// Takes the front payload of the ring. The caller must hold the mutex.
+    uint32_t pop_payload(uint8_t* payload);
+
+    /// The worker loop, which refills the ring until it is stopped
+    void run(bool pin, uint32_t cpu);
+
+private:
+
+    kodoc_coder_t m_encoder;
+    uint32_t m_payload_size;
+
+    std::mutex m_mutex;
+
+    /// Signalled by the worker when a payload was pushed
+    std::condition_variable m_ready;
+
+    /// Signalled by the consumer when a slot was freed
+    std::condition_variable m_free;
+
+    payload_ring m_ring;
+    bool m_stop;
+
+    /// The worker is declared last so that it is started after all other
+    /// members are initialized
+    std::thread m_worker;
+};
+}
@@ -0,0 +1,64 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+
+namespace kodoc
+{
+/// Interface for coders that can be reset to the state of a newly built
+/// coder without releasing their memory
+struct recycle_interface
+{
+    virtual ~recycle_interface()
+    { }
+
+    /// Re-initializes the coder with the current settings of the factory
+    /// that built it. The memory allocated when the coder was constructed
+    /// (e.g. the coefficient storage and the decoding matrix) is reused.
+    virtual void recycle() = 0;
+};
+
+/// Remembers the factory that initialized the coder, so that the coder can
+/// be initialized again by the same factory. A factory allocates the memory
+/// of a coder in construct() (sized for the maximum number of symbols and
+/// the maximum symbol size), while initialize() only resets the coding
+/// state for the symbols and symbol size that are currently configured.
+template<class Stack>
+class recycle_binding : public Stack, public virtual recycle_interface
+{
+public:
+
+    template<class Factory>
+    void initialize(Factory& the_factory)
+    {
+        Stack::initialize(the_factory);
+
+        m_factory = &the_factory;
+        m_initialize = &recycle_binding::initialize_with<Factory>;
+    }
+
+    void recycle() override
+    {
+        assert(m_factory);
+        assert(m_initialize);
+        m_initialize(*this, m_factory);
+    }
+
+private:
+
+    template<class Factory>
+    static void initialize_with(recycle_binding& coder, void* factory)
+    {
+        coder.Stack::initialize(*static_cast<Factory*>(factory));
+    }
+
+private:
+
+    void* m_factory = nullptr;
+    void (*m_initialize)(recycle_binding&, void*) = nullptr;
+};
+}
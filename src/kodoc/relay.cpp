@@ -0,0 +1,295 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include "relay.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
+namespace kodoc
+{
+relay::relay(int32_t field, uint32_t symbols, uint32_t symbol_size,
+             uint32_t max_buffered) :
+    m_field(field),
+    m_symbols(symbols),
+    m_symbol_size(symbol_size),
+    m_coefficients_size(m_field.elements_to_size(symbols)),
+    m_max_buffered(max_buffered),
+    m_stride(m_coefficients_size + symbol_size),
+    m_buffered(0),
+    m_received(0),
+    m_next_mixed(0),
+    m_storage(max_buffered * m_stride),
+    m_echelon(max_buffered * m_coefficients_size),
+    m_pivots(max_buffered),
+    m_scratch(m_coefficients_size),
+    m_unit_coefficients(m_coefficients_size),
+    m_random(std::random_device()())
+{
+    assert(m_symbols > 0);
+    assert(m_symbol_size > 0);
+    assert(m_max_buffered > 0);
+}
+
+void relay::read_symbol(const uint8_t* symbol_data,
+                        const uint8_t* coefficients)
+{
+    assert(symbol_data);
+    assert(coefficients);
+
+    // A symbol with only zero coefficients carries no information
+    bool zero = std::all_of(coefficients, coefficients + m_coefficients_size,
+                            [](uint8_t c) { return c == 0; });
+    if (zero)
+        return;
+
+    ++m_received;
+    store(symbol_data, coefficients);
+}
+
+void relay::read_uncoded_symbol(const uint8_t* symbol_data, uint32_t index)
+{
+    assert(symbol_data);
+    assert(index < m_symbols);
+
+    std::fill(m_unit_coefficients.begin(), m_unit_coefficients.end(), 0);
+    m_field.set_value(m_unit_coefficients.data(), index, 1);
+
+    ++m_received;
+    store(symbol_data, m_unit_coefficients.data());
+}
+
+void relay::store(const uint8_t* symbol_data, const uint8_t* coefficients)
+{
+    // The stored symbols span the whole generation, so every symbol is
+    // dependent
+    if (m_buffered == m_symbols)
+        return;
+
+    // Only the coefficients are reduced, so a dependent symbol costs no
+    // symbol operations
+    uint8_t* scratch = m_scratch.data();
+    memcpy(scratch, coefficients, m_coefficients_size);
+
+    uint32_t pivot = reduce(scratch, m_buffered);
+
+    // A symbol in the span of the stored symbols carries no information
+    if (pivot == m_symbols)
+        return;
+
+    if (m_buffered < m_max_buffered)
+    {
+        memcpy(stored_coefficients(m_buffered), coefficients,
+               m_coefficients_size);
+        memcpy(stored_symbol(m_buffered), symbol_data, m_symbol_size);
+
+        set_echelon_row(m_buffered, scratch, pivot);
+        ++m_buffered;
+        return;
+    }
+
+    // The symbol is independent of the stored symbols, so adding it to a
+    // stored symbol keeps the rank. The stored symbols are used in turn,
+    // so every one of them keeps absorbing new information.
+    uint32_t index = m_next_mixed;
+    m_next_mixed = (m_next_mixed + 1) % m_max_buffered;
+
+    uint8_t constant = random_nonzero();
+    m_field.region_multiply_add(stored_coefficients(index), coefficients,
+                                constant, m_coefficients_size);
+    m_field.region_multiply_add(stored_symbol(index), symbol_data,
+                                constant, m_symbol_size);
+
+    // The echelon rows before the mixed symbol do not depend on it, the
+    // rows from the mixed symbol onwards are reduced again
+    for (uint32_t i = index; i < m_buffered; ++i)
+    {
+        memcpy(scratch, stored_coefficients(i), m_coefficients_size);
+
+        uint32_t row_pivot = reduce(scratch, i);
+        assert(row_pivot < m_symbols);
+
+        set_echelon_row(i, scratch, row_pivot);
+    }
+}
+
+uint32_t relay::reduce(uint8_t* coefficients, uint32_t rows) const
+{
+    // Row i is zero at the pivots of the rows before it, so subtracting
+    // the rows in order clears every pivot for good
+    for (uint32_t i = 0; i < rows; ++i)
+    {
+        uint8_t factor = m_field.get_value(coefficients, m_pivots[i]);
+        if (factor == 0)
+            continue;
+
+        m_field.region_multiply_add(coefficients, echelon_row(i), factor,
+                                    m_coefficients_size);
+    }
+
+    uint32_t pivot = 0;
+    while (pivot < m_symbols && m_field.get_value(coefficients, pivot) == 0)
+        ++pivot;
+
+    return pivot;
+}
+
+void relay::set_echelon_row(uint32_t index, uint8_t* coefficients,
+                            uint32_t pivot)
+{
+    uint8_t inverse = m_field.invert(m_field.get_value(coefficients, pivot));
+    m_field.region_multiply(coefficients, inverse, m_coefficients_size);
+
+    memcpy(echelon_row(index), coefficients, m_coefficients_size);
+    m_pivots[index] = pivot;
+}
+
+uint32_t relay::write_symbol(uint8_t* symbol_data, uint8_t* coefficients)
+{
+    assert(symbol_data);
+    assert(coefficients);
+
+    if (m_buffered == 0)
+        return 0;
+
+    memset(coefficients, 0, m_coefficients_size);
+    memset(symbol_data, 0, m_symbol_size);
+
+    // Avoid the zero combination, which would waste a transmission
+    uint32_t forced = m_random() % m_buffered;
+
+    for (uint32_t i = 0; i < m_buffered; ++i)
+    {
+        uint8_t constant = i == forced ? random_nonzero() : random_value();
+
+        m_field.region_multiply_add(coefficients, stored_coefficients(i),
+                                    constant, m_coefficients_size);
+        m_field.region_multiply_add(symbol_data, stored_symbol(i),
+                                    constant, m_symbol_size);
+    }
+
+    return m_symbol_size;
+}
+
+void relay::reset()
+{
+    m_buffered = 0;
+    m_received = 0;
+    m_next_mixed = 0;
+}
+
+uint8_t relay::random_nonzero()
+{
+    return (uint8_t)(m_random() % m_field.max_value() + 1);
+}
+
+uint8_t relay::random_value()
+{
+    return (uint8_t)(m_random() % (m_field.max_value() + 1U));
+}
+}
+
+//------------------------------------------------------------------
+// RELAY API
+//------------------------------------------------------------------
+
+kodoc_relay_t kodoc_new_relay(int32_t finite_field, uint32_t symbols,
+                              uint32_t symbol_size, uint32_t max_buffered)
+{
+    assert(symbols > 0);
+    assert(symbol_size > 0);
+    assert(max_buffered > 0);
+    return (kodoc_relay_t) new kodoc::relay(
+        finite_field, symbols, symbol_size, max_buffered);
+}
+
+void kodoc_delete_relay(kodoc_relay_t relay)
+{
+    auto r = (kodoc::relay*) relay;
+    assert(r);
+    delete r;
+}
+
+uint32_t kodoc_relay_symbols(kodoc_relay_t relay)
+{
+    auto r = (kodoc::relay*) relay;
+    assert(r);
+    return r->symbols();
+}
+
+uint32_t kodoc_relay_symbol_size(kodoc_relay_t relay)
+{
+    auto r = (kodoc::relay*) relay;
+    assert(r);
+    return r->symbol_size();
+}
+
+uint32_t kodoc_relay_coefficient_vector_size(kodoc_relay_t relay)
+{
+    auto r = (kodoc::relay*) relay;
+    assert(r);
+    return r->coefficient_vector_size();
+}
+
+uint32_t kodoc_relay_max_buffered(kodoc_relay_t relay)
+{
+    auto r = (kodoc::relay*) relay;
+    assert(r);
+    return r->max_buffered();
+}
+
+uint32_t kodoc_relay_buffered(kodoc_relay_t relay)
+{
+    auto r = (kodoc::relay*) relay;
+    assert(r);
+    return r->buffered();
+}
+
+uint32_t kodoc_relay_received(kodoc_relay_t relay)
+{
+    auto r = (kodoc::relay*) relay;
+    assert(r);
+    return r->received();
+}
+
+uint32_t kodoc_relay_memory_size(kodoc_relay_t relay)
+{
+    auto r = (kodoc::relay*) relay;
+    assert(r);
+    return r->memory_size();
+}
+
+void kodoc_relay_read_symbol(kodoc_relay_t relay, const uint8_t* symbol_data,
+                             const uint8_t* coefficients)
+{
+    auto r = (kodoc::relay*) relay;
+    assert(r);
+    r->read_symbol(symbol_data, coefficients);
+}
+
+void kodoc_relay_read_uncoded_symbol(
+    kodoc_relay_t relay, const uint8_t* symbol_data, uint32_t index)
+{
+    auto r = (kodoc::relay*) relay;
+    assert(r);
+    r->read_uncoded_symbol(symbol_data, index);
+}
+
+uint32_t kodoc_relay_write_symbol(kodoc_relay_t relay, uint8_t* symbol_data,
+                                  uint8_t* coefficients)
+{
+    auto r = (kodoc::relay*) relay;
+    assert(r);
+    return r->write_symbol(symbol_data, coefficients);
+}
+
+void kodoc_relay_reset(kodoc_relay_t relay)
+{
+    auto r = (kodoc::relay*) relay;
+    assert(r);
+    r->reset();
+}
@@ -0,0 +1,176 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "kodoc.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "finite_field.hpp"
+
+namespace kodoc
+{
+/// Recodes the coded symbols of a generation at an intermediate node.
+/// The received symbols are stored as they are with their coefficient
+/// vectors, and new symbols are random linear combinations of the stored
+/// ones. The rank is tracked on an echelon form of the coefficient vectors
+/// only, so a received symbol costs at most one copy or multiply-add of its
+/// symbol data, and a linearly dependent symbol is dropped without touching
+/// its symbol data. The cost of a recoded symbol is one multiply-add per
+/// stored symbol. The memory is bounded by a fixed number of stored symbols
+/// that is allocated up front.
+class relay
+{
+public:
+
+    /// @param field The finite field of the generation
+    /// @param symbols The number of symbols in the generation
+    /// @param symbol_size The size of a symbol in bytes
+    /// @param max_buffered The maximum number of stored symbols
+    relay(int32_t field, uint32_t symbols, uint32_t symbol_size,
+          uint32_t max_buffered);
+
+    uint32_t symbols() const
+    {
+        return m_symbols;
+    }
+
+    uint32_t symbol_size() const
+    {
+        return m_symbol_size;
+    }
+
+    uint32_t coefficient_vector_size() const
+    {
+        return m_coefficients_size;
+    }
+
+    uint32_t max_buffered() const
+    {
+        return m_max_buffered;
+    }
+
+    /// @return The number of stored symbols
+    uint32_t buffered() const
+    {
+        return m_buffered;
+    }
+
+    /// @return The number of symbols received since the last reset
+    uint32_t received() const
+    {
+        return m_received;
+    }
+
+    /// @return The memory used for the stored symbols and the echelon
+    ///         form of their coefficients in bytes
+    uint32_t memory_size() const
+    {
+        return (uint32_t) (m_storage.size() + m_echelon.size());
+    }
+
+    /// Stores a coded symbol that is linearly independent of the stored
+    /// symbols. When the relay is full, the symbol is added to one of the
+    /// stored symbols with a random coefficient instead, so that later
+    /// recoded symbols still carry its information.
+    void read_symbol(const uint8_t* symbol_data,
+                     const uint8_t* coefficients);
+
+    /// Stores a source symbol with the given index
+    void read_uncoded_symbol(const uint8_t* symbol_data, uint32_t index);
+
+    /// Writes a random linear combination of the stored symbols
+    /// @return The bytes used from the symbol buffer, or 0 if no symbols
+    ///         are stored
+    uint32_t write_symbol(uint8_t* symbol_data, uint8_t* coefficients);
+
+    /// Forgets all stored symbols, so the relay can be used for the next
+    /// generation. The memory is kept.
+    void reset();
+
+private:
+
+    /// Checks a symbol against the stored symbols, and adds it to the
+    /// stored symbols or mixes it into one of them unless it is dependent
+    void store(const uint8_t* symbol_data, const uint8_t* coefficients);
+
+    /// Reduces a coefficient vector against the first rows of the echelon
+    /// form
+    /// @return The pivot of the reduced vector, or the number of symbols
+    ///         if the vector is zero
+    uint32_t reduce(uint8_t* coefficients, uint32_t rows) const;
+
+    /// Makes a reduced coefficient vector the echelon row of a stored
+    /// symbol
+    void set_echelon_row(uint32_t index, uint8_t* coefficients,
+                         uint32_t pivot);
+
+    uint8_t* stored_coefficients(uint32_t index)
+    {
+        return &m_storage[index * m_stride];
+    }
+
+    uint8_t* stored_symbol(uint32_t index)
+    {
+        return &m_storage[index * m_stride + m_coefficients_size];
+    }
+
+    uint8_t* echelon_row(uint32_t index)
+    {
+        return &m_echelon[index * m_coefficients_size];
+    }
+
+    const uint8_t* echelon_row(uint32_t index) const
+    {
+        return &m_echelon[index * m_coefficients_size];
+    }
+
+    /// @return A random non-zero element of the field
+    uint8_t random_nonzero();
+
+    /// @return A random element of the field
+    uint8_t random_value();
+
+private:
+
+    finite_field m_field;
+    uint32_t m_symbols;
+    uint32_t m_symbol_size;
+    uint32_t m_coefficients_size;
+    uint32_t m_max_buffered;
+
+    /// The size of a stored coefficient vector and symbol
+    uint32_t m_stride;
+
+    uint32_t m_buffered;
+    uint32_t m_received;
+
+    /// The next stored symbol that a symbol is mixed into when full
+    uint32_t m_next_mixed;
+
+    /// The stored coefficient vectors and symbols, as they were received
+    /// or mixed
+    std::vector<uint8_t> m_storage;
+
+    /// The echelon form of the stored coefficient vectors. Row i is the
+    /// coefficient vector of stored symbol i reduced against the rows
+    /// before it, so it has a one at its pivot and the rows after it have
+    /// zeros there. Mixing a symbol into stored symbol i only changes the
+    /// rows from i onwards.
+    std::vector<uint8_t> m_echelon;
+
+    /// The pivot of every row of the echelon form
+    std::vector<uint32_t> m_pivots;
+
+    /// The coefficients of a received symbol during reduction
+    std::vector<uint8_t> m_scratch;
+
+    std::vector<uint8_t> m_unit_coefficients;
+    std::mt19937 m_random;
+};
+}
@@ -11,21 +11,25 @@
 #include <kodo_core/runtime/final.hpp>
 #include <kodo_core/runtime/select_field.hpp>
 #include <kodo_core/runtime/use_shallow_encoder_storage.hpp>
-#include <kodo_core/runtime/use_trace_enabled.hpp>
 
+#include "counters_binding.hpp"
 #include "factory_binding.hpp"
+#include "recycle_binding.hpp"
+#include "use_trace.hpp"
 
 namespace kodoc
 {
 template<class Stack>
 using encoder_binding =
+    recycle_binding<
+    encoder_counters_binding<
     kodo_core::api::storage_binding<
     kodo_core::api::encoder_binding<
     kodo_core::api::rank_binding<
     kodo_core::api::write_payload_binding<
     kodo_core::api::payload_size_binding<
     kodo_core::api::coefficient_vector_size_binding<
-    kodo_core::api::final_binding<Stack>>>>>>>;
+    kodo_core::api::final_binding<Stack>>>>>>>>>;
 
 template
 <
@@ -38,7 +42,7 @@ template
 struct runtime_encoder :
     kodo_core::runtime::select_field<
     kodo_core::runtime::use_shallow_encoder_storage<
-    kodo_core::runtime::use_trace_enabled<
+    use_trace<
     kodo_core::runtime::final<Stack,
     kodo_core::runtime::extend_binding<AdditionalCoderFactoryBindings,
     factory_binding>::template type,
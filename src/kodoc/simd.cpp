@@ -0,0 +1,343 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include "simd.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
+// The x86 kernels are compiled with target attributes, so the library
+// itself can be built for the baseline instruction set
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define KODOC_SIMD_X86
+    #include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+    #define KODOC_SIMD_NEON
+    #include <arm_neon.h>
+#endif
+
+namespace kodoc
+{
+namespace
+{
+void basic_region_add(uint8_t* dest, const uint8_t* src, uint32_t size)
+{
+    for (uint32_t i = 0; i < size; ++i)
+        dest[i] ^= src[i];
+}
+
+void basic_region_multiply_add(uint8_t* dest, const uint8_t* src,
+                               const multiply_table& table, uint32_t size)
+{
+    for (uint32_t i = 0; i < size; ++i)
+        dest[i] ^= table.bytes[src[i]];
+}
+
+void basic_region_multiply(uint8_t* dest, const multiply_table& table,
+                           uint32_t size)
+{
+    for (uint32_t i = 0; i < size; ++i)
+        dest[i] = table.bytes[dest[i]];
+}
+
+void basic_region_copy_nontemporal(uint8_t* dest, const uint8_t* src,
+                                   uint32_t size)
+{
+    memcpy(dest, src, size);
+}
+
+#if defined(KODOC_SIMD_X86)
+
+// The products of 16 or 32 bytes are looked up in the nibble tables with
+// a byte shuffle, and the bytes after the last full vector are left to the
+// basic kernels
+
+__attribute__((target("ssse3")))
+void ssse3_region_add(uint8_t* dest, const uint8_t* src, uint32_t size)
+{
+    uint32_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        __m128i s = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i d = _mm_loadu_si128((const __m128i*)(dest + i));
+        _mm_storeu_si128((__m128i*)(dest + i), _mm_xor_si128(d, s));
+    }
+    basic_region_add(dest + i, src + i, size - i);
+}
+
+__attribute__((target("ssse3")))
+inline __m128i ssse3_multiply(__m128i v, __m128i low, __m128i high)
+{
+    const __m128i mask = _mm_set1_epi8(0x0F);
+    __m128i l = _mm_shuffle_epi8(low, _mm_and_si128(v, mask));
+    __m128i h = _mm_shuffle_epi8(
+        high, _mm_and_si128(_mm_srli_epi64(v, 4), mask));
+    return _mm_xor_si128(l, h);
+}
+
+__attribute__((target("ssse3")))
+void ssse3_region_multiply_add(uint8_t* dest, const uint8_t* src,
+                               const multiply_table& table, uint32_t size)
+{
+    const __m128i low = _mm_loadu_si128((const __m128i*) table.nibbles);
+    const __m128i high =
+        _mm_loadu_si128((const __m128i*)(table.nibbles + 16));
+
+    uint32_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        __m128i s = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i d = _mm_loadu_si128((const __m128i*)(dest + i));
+        d = _mm_xor_si128(d, ssse3_multiply(s, low, high));
+        _mm_storeu_si128((__m128i*)(dest + i), d);
+    }
+    basic_region_multiply_add(dest + i, src + i, table, size - i);
+}
+
+__attribute__((target("ssse3")))
+void ssse3_region_multiply(uint8_t* dest, const multiply_table& table,
+                           uint32_t size)
+{
+    const __m128i low = _mm_loadu_si128((const __m128i*) table.nibbles);
+    const __m128i high =
+        _mm_loadu_si128((const __m128i*)(table.nibbles + 16));
+
+    uint32_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        __m128i d = _mm_loadu_si128((const __m128i*)(dest + i));
+        _mm_storeu_si128((__m128i*)(dest + i), ssse3_multiply(d, low, high));
+    }
+    basic_region_multiply(dest + i, table, size - i);
+}
+
+__attribute__((target("avx2")))
+void avx2_region_add(uint8_t* dest, const uint8_t* src, uint32_t size)
+{
+    uint32_t i = 0;
+    for (; i + 32 <= size; i += 32)
+    {
+        __m256i s = _mm256_loadu_si256((const __m256i*)(src + i));
+        __m256i d = _mm256_loadu_si256((const __m256i*)(dest + i));
+        _mm256_storeu_si256((__m256i*)(dest + i), _mm256_xor_si256(d, s));
+    }
+    basic_region_add(dest + i, src + i, size - i);
+}
+
+__attribute__((target("avx2")))
+inline __m256i avx2_multiply(__m256i v, __m256i low, __m256i high)
+{
+    const __m256i mask = _mm256_set1_epi8(0x0F);
+    __m256i l = _mm256_shuffle_epi8(low, _mm256_and_si256(v, mask));
+    __m256i h = _mm256_shuffle_epi8(
+        high, _mm256_and_si256(_mm256_srli_epi64(v, 4), mask));
+    return _mm256_xor_si256(l, h);
+}
+
+// The byte shuffle of AVX2 works within each 128-bit lane, so the nibble
+// tables are repeated in both lanes
+__attribute__((target("avx2")))
+void avx2_region_multiply_add(uint8_t* dest, const uint8_t* src,
+                              const multiply_table& table, uint32_t size)
+{
+    const __m256i low = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((const __m128i*) table.nibbles));
+    const __m256i high = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((const __m128i*)(table.nibbles + 16)));
+
+    uint32_t i = 0;
+    for (; i + 32 <= size; i += 32)
+    {
+        __m256i s = _mm256_loadu_si256((const __m256i*)(src + i));
+        __m256i d = _mm256_loadu_si256((const __m256i*)(dest + i));
+        d = _mm256_xor_si256(d, avx2_multiply(s, low, high));
+        _mm256_storeu_si256((__m256i*)(dest + i), d);
+    }
+    basic_region_multiply_add(dest + i, src + i, table, size - i);
+}
+
+__attribute__((target("avx2")))
+void avx2_region_multiply(uint8_t* dest, const multiply_table& table,
+                          uint32_t size)
+{
+    const __m256i low = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((const __m128i*) table.nibbles));
+    const __m256i high = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((const __m128i*)(table.nibbles + 16)));
+
+    uint32_t i = 0;
+    for (; i + 32 <= size; i += 32)
+    {
+        __m256i d = _mm256_loadu_si256((const __m256i*)(dest + i));
+        _mm256_storeu_si256((__m256i*)(dest + i),
+                            avx2_multiply(d, low, high));
+    }
+    basic_region_multiply(dest + i, table, size - i);
+}
+
+// The streamed stores need aligned addresses, so the bytes before the
+// first aligned address and after the last full vector are copied as
+// usual. The stores are ordered with a fence before the data is used.
+
+__attribute__((target("sse2")))
+void sse2_region_copy_nontemporal(uint8_t* dest, const uint8_t* src,
+                                  uint32_t size)
+{
+    uint32_t head = std::min(size, (uint32_t)(-(uintptr_t) dest % 16));
+    memcpy(dest, src, head);
+
+    uint32_t i = head;
+    for (; i + 16 <= size; i += 16)
+    {
+        _mm_stream_si128((__m128i*)(dest + i),
+                         _mm_loadu_si128((const __m128i*)(src + i)));
+    }
+    _mm_sfence();
+
+    memcpy(dest + i, src + i, size - i);
+}
+
+__attribute__((target("avx2")))
+void avx2_region_copy_nontemporal(uint8_t* dest, const uint8_t* src,
+                                  uint32_t size)
+{
+    uint32_t head = std::min(size, (uint32_t)(-(uintptr_t) dest % 32));
+    memcpy(dest, src, head);
+
+    uint32_t i = head;
+    for (; i + 32 <= size; i += 32)
+    {
+        _mm256_stream_si256((__m256i*)(dest + i),
+                            _mm256_loadu_si256((const __m256i*)(src + i)));
+    }
+    _mm_sfence();
+
+    memcpy(dest + i, src + i, size - i);
+}
+#endif
+
+#if defined(KODOC_SIMD_NEON)
+
+void neon_region_add(uint8_t* dest, const uint8_t* src, uint32_t size)
+{
+    uint32_t i = 0;
+    for (; i + 16 <= size; i += 16)
+        vst1q_u8(dest + i, veorq_u8(vld1q_u8(dest + i), vld1q_u8(src + i)));
+
+    basic_region_add(dest + i, src + i, size - i);
+}
+
+inline uint8x16_t neon_multiply(uint8x16_t v, uint8x16_t low,
+                                uint8x16_t high)
+{
+    uint8x16_t l = vqtbl1q_u8(low, vandq_u8(v, vdupq_n_u8(0x0F)));
+    uint8x16_t h = vqtbl1q_u8(high, vshrq_n_u8(v, 4));
+    return veorq_u8(l, h);
+}
+
+void neon_region_multiply_add(uint8_t* dest, const uint8_t* src,
+                              const multiply_table& table, uint32_t size)
+{
+    const uint8x16_t low = vld1q_u8(table.nibbles);
+    const uint8x16_t high = vld1q_u8(table.nibbles + 16);
+
+    uint32_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        uint8x16_t p = neon_multiply(vld1q_u8(src + i), low, high);
+        vst1q_u8(dest + i, veorq_u8(vld1q_u8(dest + i), p));
+    }
+    basic_region_multiply_add(dest + i, src + i, table, size - i);
+}
+
+void neon_region_multiply(uint8_t* dest, const multiply_table& table,
+                          uint32_t size)
+{
+    const uint8x16_t low = vld1q_u8(table.nibbles);
+    const uint8x16_t high = vld1q_u8(table.nibbles + 16);
+
+    uint32_t i = 0;
+    for (; i + 16 <= size; i += 16)
+        vst1q_u8(dest + i, neon_multiply(vld1q_u8(dest + i), low, high));
+
+    basic_region_multiply(dest + i, table, size - i);
+}
+
+#endif
+
+// The backends in the order of preference, the best one that the CPU
+// supports is selected
+const simd_kernels backends[] =
+{
+#if defined(KODOC_SIMD_X86)
+    {
+        simd_backend::avx2, avx2_region_add, avx2_region_multiply_add,
+        avx2_region_multiply, avx2_region_copy_nontemporal
+    },
+    {
+        simd_backend::ssse3, ssse3_region_add, ssse3_region_multiply_add,
+        ssse3_region_multiply, sse2_region_copy_nontemporal
+    },
+#endif
+#if defined(KODOC_SIMD_NEON)
+    {
+        simd_backend::neon, neon_region_add, neon_region_multiply_add,
+        neon_region_multiply, basic_region_copy_nontemporal
+    },
+#endif
+    {
+        simd_backend::none, basic_region_add, basic_region_multiply_add,
+        basic_region_multiply, basic_region_copy_nontemporal
+    }
+};
+
+bool cpu_supports(simd_backend backend)
+{
+    switch (backend)
+    {
+    case simd_backend::none:
+        return true;
+#if defined(KODOC_SIMD_X86)
+    case simd_backend::ssse3:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("ssse3");
+    case simd_backend::avx2:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+#endif
+#if defined(KODOC_SIMD_NEON)
+    // NEON is part of the baseline of the 64-bit ARM architecture
+    case simd_backend::neon:
+        return true;
+#endif
+    default:
+        return false;
+    }
+}
+
+const simd_kernels* best_backend()
+{
+    for (const simd_kernels& kernels : backends)
+    {
+        if (cpu_supports(kernels.backend))
+            return &kernels;
+    }
+
+    assert(0 && "The basic kernels are always available");
+    return nullptr;
+}
+}
+
+const simd_kernels& simd()
+{
+    // The CPU is checked on first use, which is thread-safe since C++11
+    static const simd_kernels* active = best_backend();
+    return *active;
+}
+}
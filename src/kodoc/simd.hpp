@@ -0,0 +1,63 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include "kodoc.h"
+
+#include <cstdint>
+
+namespace kodoc
+{
+/// The tables that multiply packed field elements by one constant. The
+/// multiplication is linear in every bit of a byte, so the product of a
+/// byte is also the xor of the products of its two nibbles.
+struct multiply_table
+{
+    /// The products of the 256 byte values
+    const uint8_t* bytes;
+
+    /// The products of the 16 low nibble values, followed by the products
+    /// of the 16 high nibble values
+    const uint8_t* nibbles;
+};
+
+/// The instruction sets that the kernels are written for
+enum class simd_backend
+{
+    none,
+    ssse3,
+    avx2,
+    neon
+};
+
+/// The region kernels of a SIMD backend, which operate on byte vectors of
+/// any size and alignment
+struct simd_kernels
+{
+    /// The instruction set of the kernels
+    simd_backend backend;
+
+    /// Computes dest[i] = dest[i] xor src[i]
+    void (*region_add)(uint8_t* dest, const uint8_t* src, uint32_t size);
+
+    /// Computes dest[i] = dest[i] xor table(src[i])
+    void (*region_multiply_add)(uint8_t* dest, const uint8_t* src,
+                                const multiply_table& table, uint32_t size);
+
+    /// Computes dest[i] = table(dest[i])
+    void (*region_multiply)(uint8_t* dest, const multiply_table& table,
+                            uint32_t size);
+
+    /// Copies src to dest with non-temporal stores, which bypass the
+    /// cache, for data that is not read again soon
+    void (*region_copy_nontemporal)(uint8_t* dest, const uint8_t* src,
+                                    uint32_t size);
+};
+
+/// @return The kernels of the best backend that the CPU supports, which
+///         is selected on first use
+const simd_kernels& simd();
+}
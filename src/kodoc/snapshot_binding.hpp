@@ -0,0 +1,218 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "block_header.hpp"
+
+namespace kodoc
+{
+/// Interface for decoders that can save their decoding state to a binary
+/// blob and rebuild it later without the original payloads
+struct snapshot_interface
+{
+    virtual ~snapshot_interface()
+    { }
+
+    /// @return The size of the snapshot in bytes
+    virtual uint32_t snapshot_size() const = 0;
+
+    /// Writes the snapshot to the buffer
+    /// @param buffer The buffer, which holds at least snapshot_size() bytes
+    /// @return The number of bytes written
+    virtual uint32_t snapshot(uint8_t* buffer) const = 0;
+
+    /// Rebuilds the decoding state of a snapshot in a decoder that has not
+    /// received any data, by passing the stored rows through the
+    /// elimination of the decoder
+    /// @return true if the snapshot was restored
+    virtual bool restore(const uint8_t* buffer, uint32_t size) = 0;
+};
+
+/// A snapshot holds the rows of the decoding matrix and the symbol-status
+/// arrays. It starts with a header of 32-bit words in big endian byte
+/// order: snapshot_magic, snapshot_version, symbols, symbol_size,
+/// coefficient vector size and the number of rows. Every row starts with
+/// the index of its pivot, where the uncoded_symbol_flag marks the symbols
+/// that are fully decoded. The coefficient vector follows for the other
+/// rows, and every row ends with the symbol data. Only the rows of pivot
+/// symbols are stored, so the snapshot grows with the rank of the decoder.
+const uint32_t snapshot_magic = 0x4B534E50U; // "KSNP"
+const uint32_t snapshot_version = 1;
+const uint32_t snapshot_header_size = 6 * sizeof(uint32_t);
+
+template<class Stack>
+class snapshot_binding : public Stack, public virtual snapshot_interface
+{
+public:
+
+    uint32_t snapshot_size() const override
+    {
+        uint32_t size = snapshot_header_size;
+
+        for (uint32_t i = 0; i < Stack::symbols(); ++i)
+        {
+            if (!Stack::is_symbol_pivot(i))
+                continue;
+
+            size += sizeof(uint32_t) + Stack::symbol_size();
+
+            if (!Stack::is_symbol_uncoded(i))
+                size += Stack::coefficient_vector_size();
+        }
+        return size;
+    }
+
+    uint32_t snapshot(uint8_t* buffer) const override
+    {
+        assert(buffer);
+
+        uint32_t symbol_size = Stack::symbol_size();
+        uint32_t vector_size = Stack::coefficient_vector_size();
+
+        uint8_t* row = buffer + snapshot_header_size;
+        uint32_t rows = 0;
+
+        for (uint32_t i = 0; i < Stack::symbols(); ++i)
+        {
+            if (!Stack::is_symbol_pivot(i))
+                continue;
+
+            bool uncoded = Stack::is_symbol_uncoded(i);
+            write_uint32(row, uncoded ? (i | uncoded_symbol_flag) : i);
+            row += sizeof(uint32_t);
+
+            if (!uncoded)
+            {
+                memcpy(row, Stack::coefficient_vector_data(i), vector_size);
+                row += vector_size;
+            }
+
+            memcpy(row, Stack::mutable_symbol(i), symbol_size);
+            row += symbol_size;
+            ++rows;
+        }
+
+        write_uint32(buffer, snapshot_magic);
+        write_uint32(buffer + 4, snapshot_version);
+        write_uint32(buffer + 8, Stack::symbols());
+        write_uint32(buffer + 12, symbol_size);
+        write_uint32(buffer + 16, vector_size);
+        write_uint32(buffer + 20, rows);
+
+        return (uint32_t)(row - buffer);
+    }
+
+    bool restore(const uint8_t* buffer, uint32_t size) override
+    {
+        assert(buffer);
+
+        uint32_t symbols = Stack::symbols();
+        uint32_t symbol_size = Stack::symbol_size();
+        uint32_t vector_size = Stack::coefficient_vector_size();
+
+        if (Stack::rank() != 0 || size < snapshot_header_size)
+            return false;
+
+        if (read_uint32(buffer) != snapshot_magic ||
+            read_uint32(buffer + 4) != snapshot_version ||
+            read_uint32(buffer + 8) != symbols ||
+            read_uint32(buffer + 12) != symbol_size ||
+            read_uint32(buffer + 16) != vector_size)
+        {
+            return false;
+        }
+
+        uint32_t rows = read_uint32(buffer + 20);
+        if (rows > symbols)
+            return false;
+
+        // Check the whole snapshot before the decoder is changed
+        const uint8_t* end = buffer + size;
+        const uint8_t* row = buffer + snapshot_header_size;
+        for (uint32_t i = 0; i < rows; ++i)
+        {
+            if ((uint32_t)(end - row) < sizeof(uint32_t))
+                return false;
+
+            uint32_t index = read_uint32(row);
+            uint32_t row_size = sizeof(uint32_t) + symbol_size;
+            if ((index & uncoded_symbol_flag) == 0)
+                row_size += vector_size;
+
+            if ((index & ~uncoded_symbol_flag) >= symbols ||
+                (uint32_t)(end - row) < row_size)
+            {
+                return false;
+            }
+            row += row_size;
+        }
+
+        // The decoder may change the data it reads, so every row is copied
+        // to a scratch buffer first. The uncoded symbols are inserted
+        // before the coded rows, and the coded rows in the order of their
+        // pivots, so every row lands on its old pivot. Every row still goes
+        // through the elimination of the decoder, which scans it against
+        // all pivots: the restore costs O(rank^2 * symbol_size) in the
+        // worst case. The stored rows are already reduced, so most of the
+        // multiply-adds find a zero coefficient and are skipped.
+        m_symbol.resize(symbol_size);
+        m_coefficients.resize(vector_size);
+
+        row = buffer + snapshot_header_size;
+        for (uint32_t i = 0; i < rows; ++i)
+        {
+            uint32_t index = read_uint32(row);
+            row += sizeof(uint32_t);
+
+            if ((index & uncoded_symbol_flag) == 0)
+            {
+                row += vector_size + symbol_size;
+                continue;
+            }
+
+            memcpy(m_symbol.data(), row, symbol_size);
+            row += symbol_size;
+
+            Stack::read_uncoded_symbol(
+                m_symbol.data(), index & ~uncoded_symbol_flag);
+        }
+
+        row = buffer + snapshot_header_size;
+        for (uint32_t i = 0; i < rows; ++i)
+        {
+            uint32_t index = read_uint32(row);
+            row += sizeof(uint32_t);
+
+            if ((index & uncoded_symbol_flag) != 0)
+            {
+                row += symbol_size;
+                continue;
+            }
+
+            memcpy(m_coefficients.data(), row, vector_size);
+            row += vector_size;
+            memcpy(m_symbol.data(), row, symbol_size);
+            row += symbol_size;
+
+            Stack::read_symbol(m_symbol.data(), m_coefficients.data());
+        }
+
+        // A snapshot with dependent rows cannot come from a decoder
+        return Stack::rank() == rows;
+    }
+
+private:
+
+    /// Scratch buffers for the rows that are restored
+    std::vector<uint8_t> m_symbol;
+    std::vector<uint8_t> m_coefficients;
+};
+}
@@ -0,0 +1,38 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <cstdint>
+
+#if defined(__linux__) && !defined(__ANDROID__)
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+
+namespace kodoc
+{
+/// Pins the calling thread to the given CPU core. Thread pinning is only
+/// supported on Linux, on other platforms the call has no effect.
+/// @param cpu The index of the CPU core
+/// @return true if the thread was pinned, otherwise false
+inline bool pin_current_thread(uint32_t cpu)
+{
+#if defined(__linux__) && !defined(__ANDROID__)
+    if (cpu >= CPU_SETSIZE)
+        return false;
+
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(cpu, &cpu_set);
+
+    return pthread_setaffinity_np(
+        pthread_self(), sizeof(cpu_set), &cpu_set) == 0;
+#else
+    (void) cpu;
+    return false;
+#endif
+}
+}
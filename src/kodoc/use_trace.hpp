@@ -0,0 +1,24 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#if !defined(KODOC_DISABLE_TRACE)
+#include <kodo_core/runtime/use_trace_enabled.hpp>
+#endif
+
+namespace kodoc
+{
+/// Adds the trace layers to the runtime stacks unless kodo-c is configured
+/// with the "--disable_trace" option. Without the trace layers, the coders
+/// do not check the trace state on every operation.
+#if !defined(KODOC_DISABLE_TRACE)
+template<class Super>
+using use_trace = kodo_core::runtime::use_trace_enabled<Super>;
+#else
+template<class Super>
+using use_trace = Super;
+#endif
+}
@@ -0,0 +1,141 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include "work_stealing_pool.hpp"
+
+#include <cassert>
+#include <cstdint>
+
+#include "thread_affinity.hpp"
+
+namespace kodoc
+{
+namespace
+{
+// Identifies the pool and worker index of the current thread, so that
+// tasks submitted from a worker are kept in the queue of that worker
+thread_local const work_stealing_pool* current_pool = nullptr;
+thread_local uint32_t current_worker = 0;
+}
+
+work_stealing_pool::work_stealing_pool(uint32_t threads,
+                                       const uint32_t* cpus) :
+    m_pending(0),
+    m_next_queue(0),
+    m_stop(false)
+{
+    if (threads == 0)
+        threads = std::thread::hardware_concurrency();
+
+    if (threads == 0)
+        threads = 1;
+
+    for (uint32_t i = 0; i < threads; ++i)
+        m_queues.emplace_back(new task_queue());
+
+    // The cores are passed by value, since the workers may start after
+    // the caller's array is gone
+    for (uint32_t i = 0; i < threads; ++i)
+    {
+        m_workers.emplace_back(&work_stealing_pool::run, this, i,
+                               cpus != nullptr, cpus ? cpus[i] : 0);
+    }
+}
+
+work_stealing_pool::~work_stealing_pool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wakeup.notify_all();
+
+    for (auto& worker : m_workers)
+        worker.join();
+}
+
+void work_stealing_pool::submit(task t)
+{
+    uint32_t index;
+
+    if (current_pool == this)
+        index = current_worker;
+    else
+        index = m_next_queue++ % m_queues.size();
+
+    // The pending counter is incremented first, so that it never drops
+    // below zero when a worker takes the task right after it is queued
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_pending;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_queues[index]->m_mutex);
+        m_queues[index]->m_tasks.push_back(std::move(t));
+    }
+
+    m_wakeup.notify_one();
+}
+
+void work_stealing_pool::run(uint32_t worker, bool pin, uint32_t cpu)
+{
+    current_pool = this;
+    current_worker = worker;
+
+    if (pin)
+        pin_current_thread(cpu);
+
+    while (true)
+    {
+        task t;
+        if (pop(worker, t) || steal(worker, t))
+        {
+            --m_pending;
+            t();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_wakeup.wait(lock, [this] { return m_stop || m_pending > 0; });
+
+        if (m_stop)
+            return;
+    }
+}
+
+bool work_stealing_pool::pop(uint32_t worker, task& t)
+{
+    auto& queue = *m_queues[worker];
+    std::lock_guard<std::mutex> lock(queue.m_mutex);
+
+    if (queue.m_tasks.empty())
+        return false;
+
+    t = std::move(queue.m_tasks.back());
+    queue.m_tasks.pop_back();
+    return true;
+}
+
+bool work_stealing_pool::steal(uint32_t worker, task& t)
+{
+    uint32_t queues = (uint32_t) m_queues.size();
+
+    for (uint32_t i = 1; i < queues; ++i)
+    {
+        auto& queue = *m_queues[(worker + i) % queues];
+        std::lock_guard<std::mutex> lock(queue.m_mutex);
+
+        if (queue.m_tasks.empty())
+            continue;
+
+        t = std::move(queue.m_tasks.front());
+        queue.m_tasks.pop_front();
+        return true;
+    }
+
+    return false;
+}
+}
@@ -0,0 +1,81 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace kodoc
+{
+/// A fixed size thread pool where every worker has its own task queue.
+/// Workers execute the most recently queued task of their own queue first
+/// (which keeps the data of that task hot in the cache), and steal the
+/// oldest task of another worker when their own queue is empty.
+class work_stealing_pool
+{
+public:
+
+    using task = std::function<void()>;
+
+public:
+
+    /// @param threads The number of worker threads. If 0, one thread is
+    ///        started for every hardware thread.
+    /// @param cpus Optional array of threads CPU core indices. Worker i is
+    ///        pinned to the core cpus[i]. If null, no pinning is done.
+    work_stealing_pool(uint32_t threads, const uint32_t* cpus);
+
+    /// Stops the workers after their current tasks. Tasks that are still
+    /// queued are discarded.
+    ~work_stealing_pool();
+
+    work_stealing_pool(const work_stealing_pool&) = delete;
+    work_stealing_pool& operator=(const work_stealing_pool&) = delete;
+
+    /// Queues a task. When called from a worker, the task is placed in the
+    /// queue of that worker, otherwise the queues are used round-robin.
+    void submit(task t);
+
+    /// @return The number of worker threads
+    uint32_t threads() const
+    {
+        return (uint32_t) m_queues.size();
+    }
+
+private:
+
+    struct task_queue
+    {
+        std::mutex m_mutex;
+        std::deque<task> m_tasks;
+    };
+
+    /// Runs a worker, which is pinned to the given core if pin is true
+    void run(uint32_t worker, bool pin, uint32_t cpu);
+
+    bool pop(uint32_t worker, task& t);
+
+    bool steal(uint32_t worker, task& t);
+
+private:
+
+    std::vector<std::unique_ptr<task_queue>> m_queues;
+    std::vector<std::thread> m_workers;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    std::atomic<uint32_t> m_pending;
+    std::atomic<uint32_t> m_next_queue;
+    bool m_stop;
+};
+}
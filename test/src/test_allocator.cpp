@@ -0,0 +1,164 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <kodoc/kodoc.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "test_helper.hpp"
+
+namespace
+{
+struct allocation_stats
+{
+    uint64_t allocations;
+    uint64_t outstanding_bytes;
+};
+
+void* counting_alloc(uint64_t size, void* context)
+{
+    auto stats = (allocation_stats*) context;
+    ++stats->allocations;
+    stats->outstanding_bytes += size;
+    return malloc(size);
+}
+
+void counting_free(void* pointer, uint64_t size, void* context)
+{
+    auto stats = (allocation_stats*) context;
+    stats->outstanding_bytes -= size;
+    free(pointer);
+}
+}
+
+// Encodes and decodes an object with the object coders of the factories,
+// and checks that the object data is decoded correctly
+static void encode_decode_object(kodoc_factory_t encoder_factory,
+                                 kodoc_factory_t decoder_factory,
+                                 uint64_t object_size)
+{
+    std::vector<uint8_t> data_in(object_size);
+    std::vector<uint8_t> data_out(object_size, 0);
+
+    for (auto& e : data_in)
+        e = rand() % 256;
+
+    kodoc_object_encoder_t encoder = kodoc_new_object_encoder(
+        encoder_factory, data_in.data(), object_size);
+
+    kodoc_object_decoder_t decoder = kodoc_new_object_decoder(
+        decoder_factory, data_out.data(), object_size);
+
+    uint32_t blocks = kodoc_object_encoder_blocks(encoder);
+    std::vector<uint8_t> payload(kodoc_object_encoder_payload_size(encoder));
+
+    uint32_t block = 0;
+    while (!kodoc_object_decoder_is_complete(decoder))
+    {
+        if (!kodoc_object_decoder_is_block_complete(decoder, block))
+        {
+            kodoc_object_encoder_write_payload(
+                encoder, block, payload.data());
+            kodoc_object_decoder_read_payload(decoder, payload.data());
+        }
+
+        block = (block + 1) % blocks;
+    }
+
+    EXPECT_EQ(0, memcmp(data_in.data(), data_out.data(), object_size));
+
+    kodoc_delete_object_encoder(encoder);
+    kodoc_delete_object_decoder(decoder);
+}
+
+static void test_allocator(uint32_t symbols, uint32_t symbol_size,
+                           int32_t codec, int32_t finite_field)
+{
+    allocation_stats stats = { 0, 0 };
+
+    kodoc_allocator_t allocator;
+    allocator.alloc = counting_alloc;
+    allocator.free = counting_free;
+    allocator.context = &stats;
+
+    kodoc_factory_t encoder_factory =
+        kodoc_new_encoder_factory_with_allocator(
+            codec, finite_field, symbols, symbol_size, &allocator);
+
+    kodoc_factory_t decoder_factory =
+        kodoc_new_decoder_factory_with_allocator(
+            codec, finite_field, symbols, symbol_size, &allocator);
+
+    EXPECT_EQ(symbols, kodoc_factory_max_symbols(encoder_factory));
+    EXPECT_EQ(symbol_size, kodoc_factory_max_symbol_size(decoder_factory));
+
+    uint64_t max_object_size = 4ULL * symbols * symbol_size;
+    uint64_t object_size = (rand() % max_object_size) + 1;
+    SCOPED_TRACE(testing::Message() << "object_size = " << object_size);
+
+    encode_decode_object(encoder_factory, decoder_factory, object_size);
+
+    // The object coders took their buffers from the allocator, and all of
+    // them were returned
+    EXPECT_GT(stats.allocations, 0U);
+    EXPECT_EQ(0U, stats.outstanding_bytes);
+
+    kodoc_delete_factory(encoder_factory);
+    kodoc_delete_factory(decoder_factory);
+}
+
+static void test_arena(uint32_t symbols, uint32_t symbol_size,
+                       int32_t codec, int32_t finite_field)
+{
+    kodoc_arena_t arena = kodoc_new_arena(4096);
+    EXPECT_EQ(0U, kodoc_arena_reserved(arena));
+    EXPECT_EQ(0U, kodoc_arena_used(arena));
+
+    kodoc_allocator_t allocator = kodoc_arena_allocator(arena);
+
+    kodoc_factory_t encoder_factory =
+        kodoc_new_encoder_factory_with_allocator(
+            codec, finite_field, symbols, symbol_size, &allocator);
+
+    kodoc_factory_t decoder_factory =
+        kodoc_new_decoder_factory_with_allocator(
+            codec, finite_field, symbols, symbol_size, &allocator);
+
+    uint64_t max_object_size = 4ULL * symbols * symbol_size;
+    uint64_t object_size = (rand() % max_object_size) + 1;
+    SCOPED_TRACE(testing::Message() << "object_size = " << object_size);
+
+    encode_decode_object(encoder_factory, decoder_factory, object_size);
+
+    EXPECT_GT(kodoc_arena_used(arena), 0U);
+    EXPECT_GE(kodoc_arena_reserved(arena), kodoc_arena_used(arena));
+
+    kodoc_delete_factory(encoder_factory);
+    kodoc_delete_factory(decoder_factory);
+
+    // All memory of the arena is released at once
+    kodoc_delete_arena(arena);
+}
+
+TEST(test_allocator, object_codes)
+{
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+
+    test_combinations(test_allocator, symbols, symbol_size);
+}
+
+TEST(test_allocator, arena)
+{
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+
+    test_combinations(test_arena, symbols, symbol_size);
+}
@@ -0,0 +1,154 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <kodoc/kodoc.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "test_helper.hpp"
+
+// Checks every coded symbol of a batch against the xor of the source
+// symbols with a set coefficient bit
+static void test_batch_encoder_symbols(uint32_t symbols, uint32_t symbol_size,
+                                       uint32_t count)
+{
+    kodoc_batch_encoder_t encoder =
+        kodoc_new_batch_encoder(symbols, symbol_size);
+
+    EXPECT_EQ(symbols, kodoc_batch_encoder_symbols(encoder));
+    EXPECT_EQ(symbol_size, kodoc_batch_encoder_symbol_size(encoder));
+    EXPECT_EQ(symbols * symbol_size, kodoc_batch_encoder_block_size(encoder));
+
+    uint32_t vector_size =
+        kodoc_batch_encoder_coefficient_vector_size(encoder);
+    EXPECT_EQ((symbols + 7) / 8, vector_size);
+
+    uint32_t block_size = kodoc_batch_encoder_block_size(encoder);
+    std::vector<uint8_t> data_in(block_size);
+
+    for (auto& e : data_in)
+        e = rand() % 256;
+
+    kodoc_batch_encoder_set_const_symbols(
+        encoder, data_in.data(), block_size);
+
+    std::vector<uint8_t> symbol_data(count * symbol_size);
+    std::vector<uint8_t> coefficients(count * vector_size);
+
+    EXPECT_EQ(count * symbol_size, kodoc_batch_encoder_write_symbols(
+        encoder, symbol_data.data(), coefficients.data(), count));
+
+    for (uint32_t k = 0; k < count; ++k)
+    {
+        const uint8_t* vector = &coefficients[k * vector_size];
+        std::vector<uint8_t> expected(symbol_size, 0);
+        bool coded = false;
+
+        for (uint32_t j = 0; j < symbols; ++j)
+        {
+            if (((vector[j / 8] >> (j % 8)) & 1) == 0)
+                continue;
+
+            for (uint32_t i = 0; i < symbol_size; ++i)
+                expected[i] ^= data_in[j * symbol_size + i];
+
+            coded = true;
+        }
+
+        // Every coded symbol has a coefficient, and the bits after the
+        // last symbol are zero
+        EXPECT_TRUE(coded);
+        if (symbols % 8 != 0)
+            EXPECT_EQ(0, vector[vector_size - 1] >> (symbols % 8));
+
+        EXPECT_EQ(0, memcmp(expected.data(), &symbol_data[k * symbol_size],
+                            symbol_size));
+    }
+
+    kodoc_delete_batch_encoder(encoder);
+}
+
+// Decodes the coded symbols of a batch encoder with a binary decoder
+static void test_batch_encoder_decode(uint32_t symbols, uint32_t symbol_size)
+{
+    kodoc_factory_t decoder_factory = kodoc_new_decoder_factory(
+        kodoc_full_vector, kodoc_binary, symbols, symbol_size);
+
+    kodoc_coder_t decoder = kodoc_factory_build_coder(decoder_factory);
+
+    kodoc_batch_encoder_t encoder =
+        kodoc_new_batch_encoder(symbols, symbol_size);
+
+    uint32_t block_size = kodoc_block_size(decoder);
+    EXPECT_EQ(block_size, kodoc_batch_encoder_block_size(encoder));
+
+    std::vector<uint8_t> data_in(block_size);
+    std::vector<uint8_t> data_out(block_size, 0);
+
+    for (auto& e : data_in)
+        e = rand() % 256;
+
+    kodoc_batch_encoder_set_const_symbols(
+        encoder, data_in.data(), block_size);
+    kodoc_set_mutable_symbols(decoder, data_out.data(), block_size);
+
+    uint32_t count = rand_nonzero(2 * symbols);
+    uint32_t vector_size =
+        kodoc_batch_encoder_coefficient_vector_size(encoder);
+
+    std::vector<uint8_t> symbol_data(count * symbol_size);
+    std::vector<uint8_t> coefficients(count * vector_size);
+
+    uint32_t batches = 0;
+    while (!kodoc_is_complete(decoder) && batches < 100)
+    {
+        kodoc_batch_encoder_write_symbols(
+            encoder, symbol_data.data(), coefficients.data(), count);
+
+        for (uint32_t k = 0; k < count && !kodoc_is_complete(decoder); ++k)
+        {
+            kodoc_read_symbol(decoder, &symbol_data[k * symbol_size],
+                              &coefficients[k * vector_size]);
+        }
+
+        ++batches;
+    }
+
+    EXPECT_TRUE(kodoc_is_complete(decoder) != 0);
+    EXPECT_EQ(0, memcmp(data_in.data(), data_out.data(), block_size));
+
+    kodoc_delete_batch_encoder(encoder);
+
+    kodoc_delete_coder(decoder);
+    kodoc_delete_factory(decoder_factory);
+}
+
+TEST(test_batch_encoder, write_symbols)
+{
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+
+    test_batch_encoder_symbols(symbols, symbol_size, 1);
+    test_batch_encoder_symbols(symbols, symbol_size, rand_nonzero(100));
+
+    // A batch of more than 1 MB is written with non-temporal stores
+    test_batch_encoder_symbols(16, 4096, 300);
+}
+
+TEST(test_batch_encoder, decode)
+{
+    if (kodoc_has_codec(kodoc_full_vector) == false)
+        return;
+
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+
+    test_batch_encoder_decode(symbols, symbol_size);
+}
@@ -28,7 +28,11 @@ static void test_coder(kodoc_coder_t coder, uint32_t symbols,
         EXPECT_TRUE(kodoc_has_feedback_size(coder) == 0);
     }
 
+#if !defined(KODOC_DISABLE_TRACE)
     EXPECT_TRUE(kodoc_has_trace_interface(coder) != 0);
+#else
+    EXPECT_TRUE(kodoc_has_trace_interface(coder) == 0);
+#endif
     kodoc_set_trace_stdout(coder);
     kodoc_set_trace_off(coder);
     kodoc_set_zone_prefix(coder, "prefix");
@@ -0,0 +1,74 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <kodoc/kodoc.h>
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include "test_helper.hpp"
+
+static void check_capability(kodoc_coder_t coder, uint32_t flag,
+                             uint8_t expected)
+{
+    uint32_t capabilities = kodoc_coder_capabilities(coder);
+    EXPECT_EQ(expected != 0, (capabilities & flag) != 0);
+}
+
+static void test_coder_capabilities(uint32_t symbols, uint32_t symbol_size,
+                                    int32_t codec, int32_t finite_field)
+{
+    kodoc_factory_t encoder_factory =
+        kodoc_new_encoder_factory(codec, finite_field, symbols, symbol_size);
+
+    kodoc_factory_t decoder_factory =
+        kodoc_new_decoder_factory(codec, finite_field, symbols, symbol_size);
+
+    kodoc_coder_t encoder = kodoc_factory_build_coder(encoder_factory);
+    kodoc_coder_t decoder = kodoc_factory_build_coder(decoder_factory);
+
+    // Every encoder writes payloads, and every decoder reads them
+    EXPECT_NE(0U, kodoc_coder_capabilities(encoder) &
+              kodoc_capability_write_payload);
+    EXPECT_NE(0U, kodoc_coder_capabilities(decoder) &
+              kodoc_capability_read_payload);
+    EXPECT_EQ(0U, kodoc_coder_capabilities(encoder) &
+              kodoc_capability_read_payload);
+
+    kodoc_coder_t coders[] = { encoder, decoder };
+    for (kodoc_coder_t coder : coders)
+    {
+        check_capability(coder, kodoc_capability_write_payload,
+                         kodoc_has_write_payload(coder));
+        check_capability(coder, kodoc_capability_feedback_size,
+                         kodoc_has_feedback_size(coder));
+        check_capability(coder, kodoc_capability_partial_decoding,
+                         kodoc_has_partial_decoding_interface(coder));
+        check_capability(
+            coder, kodoc_capability_symbol_decoding_status_updater,
+            kodoc_has_symbol_decoding_status_updater_interface(coder));
+        check_capability(coder, kodoc_capability_systematic,
+                         kodoc_has_systematic_interface(coder));
+        check_capability(coder, kodoc_capability_trace,
+                         kodoc_has_trace_interface(coder));
+        check_capability(coder, kodoc_capability_snapshot,
+                         kodoc_has_snapshot_interface(coder));
+    }
+
+    kodoc_delete_coder(encoder);
+    kodoc_delete_coder(decoder);
+
+    kodoc_delete_factory(encoder_factory);
+    kodoc_delete_factory(decoder_factory);
+}
+
+TEST(test_coder_capabilities, has_functions)
+{
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+
+    test_combinations(test_coder_capabilities, symbols, symbol_size);
+}
@@ -0,0 +1,110 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <kodoc/kodoc.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "test_helper.hpp"
+
+static void encode_decode(kodoc_coder_t encoder, kodoc_coder_t decoder)
+{
+    EXPECT_EQ(0U, kodoc_rank(decoder));
+    EXPECT_TRUE(kodoc_is_complete(decoder) == 0);
+
+    uint32_t block_size = kodoc_block_size(encoder);
+    std::vector<uint8_t> data_in(block_size);
+    std::vector<uint8_t> data_out(block_size, 0);
+
+    for (auto& e : data_in)
+        e = rand() % 256;
+
+    kodoc_set_const_symbols(encoder, data_in.data(), block_size);
+    kodoc_set_mutable_symbols(decoder, data_out.data(), block_size);
+
+    std::vector<uint8_t> payload(kodoc_payload_size(encoder));
+
+    while (!kodoc_is_complete(decoder))
+    {
+        kodoc_write_payload(encoder, payload.data());
+        kodoc_read_payload(decoder, payload.data());
+    }
+
+    EXPECT_EQ(kodoc_symbols(decoder), kodoc_rank(decoder));
+    EXPECT_EQ(0, memcmp(data_in.data(), data_out.data(), block_size));
+}
+
+static void test_coder_pool(uint32_t symbols, uint32_t symbol_size,
+                            int32_t codec, int32_t finite_field)
+{
+    kodoc_factory_t encoder_factory =
+        kodoc_new_encoder_factory(codec, finite_field, symbols, symbol_size);
+
+    kodoc_factory_t decoder_factory =
+        kodoc_new_decoder_factory(codec, finite_field, symbols, symbol_size);
+
+    kodoc_coder_pool_t encoder_pool = kodoc_new_coder_pool(encoder_factory);
+    kodoc_coder_pool_t decoder_pool = kodoc_new_coder_pool(decoder_factory);
+
+    EXPECT_EQ(0U, kodoc_coder_pool_idle(encoder_pool));
+    EXPECT_EQ(0U, kodoc_coder_pool_idle(decoder_pool));
+
+    kodoc_coder_t encoder = kodoc_coder_pool_acquire(encoder_pool);
+    kodoc_coder_t decoder = kodoc_coder_pool_acquire(decoder_pool);
+
+    encode_decode(encoder, decoder);
+
+    kodoc_coder_pool_release(encoder_pool, encoder);
+    kodoc_coder_pool_release(decoder_pool, decoder);
+
+    EXPECT_EQ(1U, kodoc_coder_pool_idle(encoder_pool));
+    EXPECT_EQ(1U, kodoc_coder_pool_idle(decoder_pool));
+
+    // Reuse the coders for several blocks with a varying number of symbols
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        uint32_t block_symbols = rand_nonzero(symbols);
+        kodoc_factory_set_symbols(encoder_factory, block_symbols);
+        kodoc_factory_set_symbols(decoder_factory, block_symbols);
+
+        kodoc_coder_t recycled_encoder =
+            kodoc_coder_pool_acquire(encoder_pool);
+        kodoc_coder_t recycled_decoder =
+            kodoc_coder_pool_acquire(decoder_pool);
+
+        // The idle coders should be handed out instead of new ones
+        EXPECT_EQ(encoder, recycled_encoder);
+        EXPECT_EQ(decoder, recycled_decoder);
+        EXPECT_EQ(0U, kodoc_coder_pool_idle(encoder_pool));
+        EXPECT_EQ(0U, kodoc_coder_pool_idle(decoder_pool));
+
+        EXPECT_EQ(block_symbols, kodoc_symbols(recycled_encoder));
+        EXPECT_EQ(block_symbols, kodoc_symbols(recycled_decoder));
+
+        encode_decode(recycled_encoder, recycled_decoder);
+
+        kodoc_coder_pool_release(encoder_pool, recycled_encoder);
+        kodoc_coder_pool_release(decoder_pool, recycled_decoder);
+    }
+
+    kodoc_delete_coder_pool(encoder_pool);
+    kodoc_delete_coder_pool(decoder_pool);
+
+    kodoc_delete_factory(encoder_factory);
+    kodoc_delete_factory(decoder_factory);
+}
+
+TEST(test_coder_pool, recycle)
+{
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+
+    test_combinations(test_coder_pool, symbols, symbol_size);
+}
@@ -0,0 +1,119 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <kodoc/kodoc.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "test_helper.hpp"
+
+static void test_counters(uint32_t symbols, uint32_t symbol_size,
+                          int32_t codec, int32_t finite_field)
+{
+    kodoc_factory_t encoder_factory =
+        kodoc_new_encoder_factory(codec, finite_field, symbols, symbol_size);
+
+    kodoc_factory_t decoder_factory =
+        kodoc_new_decoder_factory(codec, finite_field, symbols, symbol_size);
+
+    kodoc_coder_t encoder = kodoc_factory_build_coder(encoder_factory);
+    kodoc_coder_t decoder = kodoc_factory_build_coder(decoder_factory);
+
+    kodoc_counters_t encoder_counters;
+    kodoc_counters_t decoder_counters;
+
+    // A new coder starts with all counters at zero
+    kodoc_get_counters(encoder, &encoder_counters);
+    EXPECT_EQ(0U, encoder_counters.payloads_written);
+    EXPECT_EQ(0U, encoder_counters.encode_nanoseconds);
+
+    kodoc_get_counters(decoder, &decoder_counters);
+    EXPECT_EQ(0U, decoder_counters.payloads_read);
+    EXPECT_EQ(0U, decoder_counters.decode_nanoseconds);
+
+    uint32_t block_size = kodoc_block_size(encoder);
+    std::vector<uint8_t> data_in(block_size);
+    std::vector<uint8_t> data_out(block_size, 0);
+
+    for (auto& e : data_in)
+        e = rand() % 256;
+
+    kodoc_set_const_symbols(encoder, data_in.data(), block_size);
+    kodoc_set_mutable_symbols(decoder, data_out.data(), block_size);
+
+    bool systematic = kodoc_has_systematic_interface(encoder) &&
+        kodoc_is_systematic_on(encoder);
+
+    std::vector<uint8_t> payload(kodoc_payload_size(encoder));
+
+    uint64_t payloads = 0;
+    while (!kodoc_is_complete(decoder))
+    {
+        kodoc_write_payload(encoder, payload.data());
+        kodoc_read_payload(decoder, payload.data());
+        ++payloads;
+    }
+
+    // A payload that is read after the decoder is complete is redundant
+    kodoc_write_payload(encoder, payload.data());
+    kodoc_read_payload(decoder, payload.data());
+    ++payloads;
+
+    EXPECT_EQ(0, memcmp(data_in.data(), data_out.data(), block_size));
+
+    kodoc_get_counters(encoder, &encoder_counters);
+    kodoc_get_counters(decoder, &decoder_counters);
+
+    EXPECT_EQ(payloads, encoder_counters.payloads_written);
+    EXPECT_EQ(0U, encoder_counters.payloads_read);
+    EXPECT_EQ(payloads, encoder_counters.systematic_sent +
+              encoder_counters.coded_sent);
+
+    if (systematic)
+    {
+        EXPECT_EQ(std::min<uint64_t>(payloads, symbols),
+                  encoder_counters.systematic_sent);
+    }
+    else
+    {
+        EXPECT_EQ(0U, encoder_counters.systematic_sent);
+    }
+
+    EXPECT_EQ(payloads, decoder_counters.payloads_read);
+    EXPECT_EQ(0U, decoder_counters.payloads_written);
+    EXPECT_GE(decoder_counters.linearly_dependent, 1U);
+    EXPECT_EQ(kodoc_rank(decoder), decoder_counters.payloads_read -
+              decoder_counters.linearly_dependent);
+
+    kodoc_reset_counters(encoder);
+    kodoc_reset_counters(decoder);
+
+    kodoc_get_counters(encoder, &encoder_counters);
+    kodoc_get_counters(decoder, &decoder_counters);
+
+    EXPECT_EQ(0U, encoder_counters.payloads_written);
+    EXPECT_EQ(0U, decoder_counters.payloads_read);
+    EXPECT_EQ(0U, decoder_counters.linearly_dependent);
+
+    kodoc_delete_coder(encoder);
+    kodoc_delete_coder(decoder);
+
+    kodoc_delete_factory(encoder_factory);
+    kodoc_delete_factory(decoder_factory);
+}
+
+TEST(test_counters, encode_decode)
+{
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+
+    test_combinations(test_counters, symbols, symbol_size);
+}
@@ -0,0 +1,133 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <kodoc/kodoc.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "test_helper.hpp"
+
+static void test_decoder_snapshot(uint32_t symbols, uint32_t symbol_size,
+                                  int32_t codec, int32_t finite_field)
+{
+    kodoc_factory_t encoder_factory =
+        kodoc_new_encoder_factory(codec, finite_field, symbols, symbol_size);
+
+    kodoc_factory_t decoder_factory =
+        kodoc_new_decoder_factory(codec, finite_field, symbols, symbol_size);
+
+    kodoc_coder_t encoder = kodoc_factory_build_coder(encoder_factory);
+    kodoc_coder_t decoder = kodoc_factory_build_coder(decoder_factory);
+
+    if (!kodoc_has_snapshot_interface(decoder))
+    {
+        kodoc_delete_coder(encoder);
+        kodoc_delete_coder(decoder);
+        kodoc_delete_factory(encoder_factory);
+        kodoc_delete_factory(decoder_factory);
+        return;
+    }
+
+    uint32_t block_size = kodoc_block_size(encoder);
+    std::vector<uint8_t> data_in(block_size);
+    std::vector<uint8_t> data_out(block_size, 0);
+
+    for (auto& e : data_in)
+        e = rand() % 256;
+
+    kodoc_set_const_symbols(encoder, data_in.data(), block_size);
+    kodoc_set_mutable_symbols(decoder, data_out.data(), block_size);
+
+    // Mix uncoded and coded rows in the decoding matrix
+    if (kodoc_has_systematic_interface(encoder))
+        kodoc_set_systematic_off(encoder);
+
+    std::vector<uint8_t> payload(kodoc_payload_size(encoder));
+
+    uint32_t half = symbols / 2;
+    for (uint32_t i = 0; i < half; i += 2)
+        kodoc_read_uncoded_symbol(decoder, &data_in[i * symbol_size], i);
+
+    while (kodoc_rank(decoder) < half)
+    {
+        kodoc_write_payload(encoder, payload.data());
+        kodoc_read_payload(decoder, payload.data());
+    }
+
+    // An empty snapshot only holds the header
+    kodoc_coder_t empty = kodoc_factory_build_coder(decoder_factory);
+    std::vector<uint8_t> empty_out(block_size, 0);
+    kodoc_set_mutable_symbols(empty, empty_out.data(), block_size);
+    uint32_t empty_size = kodoc_decoder_snapshot_size(empty);
+    EXPECT_GT(empty_size, 0U);
+
+    uint32_t size = kodoc_decoder_snapshot_size(decoder);
+    EXPECT_GE(size, empty_size + kodoc_rank(decoder) * symbol_size);
+
+    std::vector<uint8_t> snapshot(size);
+    EXPECT_EQ(size, kodoc_decoder_snapshot(decoder, snapshot.data()));
+
+    // A damaged or truncated snapshot is rejected
+    std::vector<uint8_t> damaged = snapshot;
+    damaged[0] ^= 0xFF;
+    EXPECT_EQ(0, kodoc_decoder_restore(empty, damaged.data(), size));
+    EXPECT_EQ(0, kodoc_decoder_restore(empty, snapshot.data(), size - 1));
+    EXPECT_EQ(0U, kodoc_rank(empty));
+
+    // Restore the snapshot in a new decoder and compare the state
+    kodoc_coder_t restored = kodoc_factory_build_coder(decoder_factory);
+    std::vector<uint8_t> restored_out(block_size, 0);
+    kodoc_set_mutable_symbols(restored, restored_out.data(), block_size);
+
+    EXPECT_NE(0, kodoc_decoder_restore(restored, snapshot.data(), size));
+    EXPECT_EQ(kodoc_rank(decoder), kodoc_rank(restored));
+
+    for (uint32_t i = 0; i < symbols; ++i)
+    {
+        EXPECT_EQ(kodoc_is_symbol_pivot(decoder, i),
+                  kodoc_is_symbol_pivot(restored, i));
+
+        if (kodoc_is_symbol_uncoded(decoder, i))
+        {
+            EXPECT_TRUE(kodoc_is_symbol_uncoded(restored, i) != 0);
+            EXPECT_EQ(0, memcmp(&data_in[i * symbol_size],
+                                &restored_out[i * symbol_size],
+                                symbol_size));
+        }
+    }
+
+    // A decoder that already holds data cannot be restored
+    EXPECT_EQ(0, kodoc_decoder_restore(restored, snapshot.data(), size));
+
+    // The restored decoder continues with the payloads of the encoder
+    while (!kodoc_is_complete(restored))
+    {
+        kodoc_write_payload(encoder, payload.data());
+        kodoc_read_payload(restored, payload.data());
+    }
+
+    EXPECT_EQ(0, memcmp(data_in.data(), restored_out.data(), block_size));
+
+    kodoc_delete_coder(encoder);
+    kodoc_delete_coder(decoder);
+    kodoc_delete_coder(empty);
+    kodoc_delete_coder(restored);
+
+    kodoc_delete_factory(encoder_factory);
+    kodoc_delete_factory(decoder_factory);
+}
+
+TEST(test_decoder_snapshot, restore)
+{
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+
+    test_combinations(test_decoder_snapshot, symbols, symbol_size);
+}
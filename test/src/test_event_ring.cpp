@@ -0,0 +1,171 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <kodoc/kodoc.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "test_helper.hpp"
+
+static void test_event_ring(uint32_t symbols, uint32_t symbol_size,
+                            int32_t codec, int32_t finite_field)
+{
+    kodoc_factory_t encoder_factory =
+        kodoc_new_encoder_factory(codec, finite_field, symbols, symbol_size);
+
+    kodoc_factory_t decoder_factory =
+        kodoc_new_decoder_factory(codec, finite_field, symbols, symbol_size);
+
+    kodoc_coder_t encoder = kodoc_factory_build_coder(encoder_factory);
+    kodoc_coder_t decoder = kodoc_factory_build_coder(decoder_factory);
+
+    // The rings are large enough to hold all events of the generation
+    uint32_t max_payloads = 8 * symbols + 32;
+    kodoc_event_ring_t encoder_events =
+        kodoc_new_event_ring(max_payloads + 1);
+    kodoc_event_ring_t decoder_events =
+        kodoc_new_event_ring(max_payloads + 1);
+    EXPECT_GE(kodoc_event_ring_capacity(encoder_events), max_payloads + 1);
+
+    kodoc_set_event_ring(encoder, encoder_events);
+    kodoc_set_event_ring(decoder, decoder_events);
+
+    uint32_t block_size = kodoc_block_size(encoder);
+    std::vector<uint8_t> data_in(block_size);
+    std::vector<uint8_t> data_out(block_size, 0);
+
+    for (auto& e : data_in)
+        e = rand() % 256;
+
+    kodoc_set_const_symbols(encoder, data_in.data(), block_size);
+    kodoc_set_mutable_symbols(decoder, data_out.data(), block_size);
+
+    std::vector<uint8_t> payload(kodoc_payload_size(encoder));
+
+    uint32_t payloads = 0;
+    while (!kodoc_is_complete(decoder) && payloads < max_payloads)
+    {
+        kodoc_write_payload(encoder, payload.data());
+        kodoc_read_payload(decoder, payload.data());
+        ++payloads;
+    }
+
+    EXPECT_TRUE(kodoc_is_complete(decoder) != 0);
+
+    std::vector<kodoc_event_t> events(2 * max_payloads);
+
+    // Every written payload is an event of the encoder
+    uint32_t count = kodoc_read_events(
+        encoder_events, events.data(), (uint32_t) events.size());
+    EXPECT_EQ(payloads, count);
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        EXPECT_EQ((uint32_t) kodoc_event_payload_written, events[i].type);
+        EXPECT_EQ(symbols, events[i].rank);
+        EXPECT_GT(events[i].bytes, 0U);
+
+        if (i > 0)
+        {
+            EXPECT_GE(events[i].timestamp, events[i - 1].timestamp);
+        }
+    }
+
+    // The decoder records a read for every payload, and the rank only
+    // grows with the innovative payloads
+    count = kodoc_read_events(
+        decoder_events, events.data(), (uint32_t) events.size());
+    EXPECT_EQ(payloads + 1, count);
+
+    uint32_t rank = 0;
+    for (uint32_t i = 0; i + 1 < count; ++i)
+    {
+        if (events[i].type == kodoc_event_payload_read)
+        {
+            EXPECT_EQ(rank + 1, events[i].rank);
+        }
+        else
+        {
+            EXPECT_EQ((uint32_t) kodoc_event_dependent_payload_read,
+                      events[i].type);
+            EXPECT_EQ(rank, events[i].rank);
+        }
+        rank = events[i].rank;
+    }
+
+    EXPECT_EQ((uint32_t) kodoc_event_decoding_complete,
+              events[count - 1].type);
+    EXPECT_EQ(symbols, events[count - 1].rank);
+
+    // All events were consumed
+    EXPECT_EQ(0U, kodoc_read_events(decoder_events, events.data(), 1));
+    EXPECT_EQ(0U, kodoc_event_ring_dropped(decoder_events));
+
+    kodoc_set_event_ring(encoder, NULL);
+    kodoc_set_event_ring(decoder, NULL);
+
+    kodoc_delete_event_ring(encoder_events);
+    kodoc_delete_event_ring(decoder_events);
+
+    kodoc_delete_coder(encoder);
+    kodoc_delete_coder(decoder);
+
+    kodoc_delete_factory(encoder_factory);
+    kodoc_delete_factory(decoder_factory);
+}
+
+TEST(test_event_ring, encode_decode)
+{
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+
+    test_combinations(test_event_ring, symbols, symbol_size);
+}
+
+TEST(test_event_ring, overwrite_oldest)
+{
+    if (kodoc_has_codec(kodoc_full_vector) == false)
+        return;
+
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+
+    kodoc_factory_t encoder_factory = kodoc_new_encoder_factory(
+        kodoc_full_vector, kodoc_binary8, symbols, symbol_size);
+
+    kodoc_coder_t encoder = kodoc_factory_build_coder(encoder_factory);
+
+    std::vector<uint8_t> data_in(kodoc_block_size(encoder));
+    kodoc_set_const_symbols(encoder, data_in.data(), data_in.size());
+
+    kodoc_event_ring_t ring = kodoc_new_event_ring(16);
+    uint32_t capacity = kodoc_event_ring_capacity(ring);
+    EXPECT_EQ(16U, capacity);
+
+    kodoc_set_event_ring(encoder, ring);
+
+    std::vector<uint8_t> payload(kodoc_payload_size(encoder));
+    for (uint32_t i = 0; i < 3 * capacity; ++i)
+        kodoc_write_payload(encoder, payload.data());
+
+    // Only the latest events are kept
+    std::vector<kodoc_event_t> events(4 * capacity);
+    uint32_t count = kodoc_read_events(
+        ring, events.data(), (uint32_t) events.size());
+
+    EXPECT_EQ(capacity, count);
+    EXPECT_EQ(2U * capacity, kodoc_event_ring_dropped(ring));
+
+    kodoc_set_event_ring(encoder, NULL);
+    kodoc_delete_event_ring(ring);
+
+    kodoc_delete_coder(encoder);
+    kodoc_delete_factory(encoder_factory);
+}
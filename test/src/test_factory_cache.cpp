@@ -0,0 +1,101 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <kodoc/kodoc.h>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "test_helper.hpp"
+
+static void test_factory_cache(uint32_t symbols, uint32_t symbol_size,
+                               int32_t codec, int32_t finite_field)
+{
+    kodoc_factory_t encoder_factory = kodoc_acquire_encoder_factory(
+        codec, finite_field, symbols, symbol_size);
+    kodoc_factory_t decoder_factory = kodoc_acquire_decoder_factory(
+        codec, finite_field, symbols, symbol_size);
+
+    ASSERT_TRUE(encoder_factory != 0);
+    ASSERT_TRUE(decoder_factory != 0);
+    EXPECT_NE(encoder_factory, decoder_factory);
+
+    EXPECT_EQ(symbols, kodoc_factory_max_symbols(encoder_factory));
+    EXPECT_EQ(symbol_size, kodoc_factory_max_symbol_size(encoder_factory));
+    EXPECT_EQ(symbols, kodoc_factory_max_symbols(decoder_factory));
+    EXPECT_EQ(symbol_size, kodoc_factory_max_symbol_size(decoder_factory));
+
+    // The same parameters should give the same factory
+    EXPECT_EQ(encoder_factory, kodoc_acquire_encoder_factory(
+        codec, finite_field, symbols, symbol_size));
+    EXPECT_EQ(decoder_factory, kodoc_acquire_decoder_factory(
+        codec, finite_field, symbols, symbol_size));
+
+    // Different parameters should give a different factory
+    kodoc_factory_t other_factory = kodoc_acquire_encoder_factory(
+        codec, finite_field, symbols + 1, symbol_size);
+    EXPECT_NE(encoder_factory, other_factory);
+    EXPECT_EQ(symbols + 1, kodoc_factory_max_symbols(other_factory));
+    kodoc_release_factory(other_factory);
+
+    // The factories are still referenced once, so they should be usable
+    kodoc_release_factory(encoder_factory);
+    kodoc_release_factory(decoder_factory);
+
+    kodoc_coder_t encoder = kodoc_factory_build_coder(encoder_factory);
+    kodoc_coder_t decoder = kodoc_factory_build_coder(decoder_factory);
+
+    EXPECT_EQ(symbols, kodoc_symbols(encoder));
+    EXPECT_EQ(symbols, kodoc_symbols(decoder));
+
+    kodoc_delete_coder(encoder);
+    kodoc_delete_coder(decoder);
+
+    kodoc_release_factory(encoder_factory);
+    kodoc_release_factory(decoder_factory);
+}
+
+TEST(test_factory_cache, acquire_release)
+{
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+
+    test_combinations(test_factory_cache, symbols, symbol_size);
+}
+
+TEST(test_factory_cache, concurrent_build)
+{
+    if (kodoc_has_codec(kodoc_full_vector) == false)
+        return;
+
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+
+    kodoc_factory_t factory = kodoc_acquire_encoder_factory(
+        kodoc_full_vector, kodoc_binary8, symbols, symbol_size);
+
+    // The tenants of a shared factory build their coders at the same time
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        threads.emplace_back([factory, symbols]
+        {
+            for (uint32_t j = 0; j < 50; ++j)
+            {
+                kodoc_coder_t coder = kodoc_factory_build_coder(factory);
+                EXPECT_EQ(symbols, kodoc_symbols(coder));
+                kodoc_delete_coder(coder);
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    kodoc_release_factory(factory);
+}
@@ -0,0 +1,142 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <kodoc/kodoc.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "test_helper.hpp"
+
+// Memory mapped files are only supported on POSIX systems
+#if !defined(_WIN32)
+
+static const char* source_path = "test_file_codes_source.bin";
+static const char* destination_path = "test_file_codes_destination.bin";
+
+static std::vector<uint8_t> read_file(const char* path)
+{
+    std::vector<uint8_t> data;
+
+    FILE* file = fopen(path, "rb");
+    if (file == NULL)
+        return data;
+
+    uint8_t buffer[4096];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+        data.insert(data.end(), buffer, buffer + read);
+
+    fclose(file);
+    return data;
+}
+
+static void test_file_codes(uint32_t symbols, uint32_t symbol_size,
+                            int32_t codec, int32_t finite_field)
+{
+    kodoc_factory_t encoder_factory =
+        kodoc_new_encoder_factory(codec, finite_field, symbols, symbol_size);
+
+    kodoc_factory_t decoder_factory =
+        kodoc_new_decoder_factory(codec, finite_field, symbols, symbol_size);
+
+    // Use a file that spans a few blocks
+    uint64_t max_file_size = 4ULL * symbols * symbol_size;
+    uint64_t file_size = (rand() % max_file_size) + 1;
+    SCOPED_TRACE(testing::Message() << "file_size = " << file_size);
+
+    std::vector<uint8_t> data_in(file_size);
+    for (auto& e : data_in)
+        e = rand() % 256;
+
+    FILE* source = fopen(source_path, "wb");
+    ASSERT_TRUE(source != NULL);
+    ASSERT_EQ(file_size, fwrite(data_in.data(), 1, file_size, source));
+    fclose(source);
+
+    kodoc_file_encoder_t encoder =
+        kodoc_file_encoder_open(encoder_factory, source_path);
+    ASSERT_TRUE(encoder != 0);
+    EXPECT_EQ(file_size, kodoc_file_encoder_file_size(encoder));
+
+    kodoc_file_decoder_t decoder = kodoc_file_decoder_open(
+        decoder_factory, destination_path,
+        kodoc_file_encoder_file_size(encoder));
+    ASSERT_TRUE(decoder != 0);
+    EXPECT_EQ(file_size, kodoc_file_decoder_file_size(decoder));
+
+    uint32_t blocks = kodoc_file_encoder_blocks(encoder);
+    EXPECT_EQ(blocks, kodoc_file_decoder_blocks(decoder));
+
+    uint32_t payload_size = kodoc_file_encoder_payload_size(encoder);
+    EXPECT_EQ(payload_size, kodoc_file_decoder_payload_size(decoder));
+
+    std::vector<uint8_t> payload(payload_size);
+
+    // Send the blocks one after the other, like a file transfer would
+    for (uint32_t block = 0; block < blocks; ++block)
+    {
+        while (!kodoc_file_decoder_is_block_complete(decoder, block))
+        {
+            kodoc_file_encoder_write_payload(encoder, block, payload.data());
+            EXPECT_EQ(block, kodoc_file_decoder_read_payload(
+                decoder, payload.data()));
+        }
+    }
+
+    EXPECT_TRUE(kodoc_file_decoder_is_complete(decoder) != 0);
+
+    kodoc_file_encoder_close(encoder);
+    kodoc_file_decoder_close(decoder);
+
+    EXPECT_EQ(data_in, read_file(destination_path));
+
+    remove(source_path);
+    remove(destination_path);
+
+    kodoc_delete_factory(encoder_factory);
+    kodoc_delete_factory(decoder_factory);
+}
+
+TEST(test_file_codes, encode_decode)
+{
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+
+    test_combinations(test_file_codes, symbols, symbol_size);
+}
+
+static void test_missing_file(uint32_t symbols, uint32_t symbol_size,
+                              int32_t codec, int32_t finite_field)
+{
+    kodoc_factory_t encoder_factory =
+        kodoc_new_encoder_factory(codec, finite_field, symbols, symbol_size);
+
+    kodoc_factory_t decoder_factory =
+        kodoc_new_decoder_factory(codec, finite_field, symbols, symbol_size);
+
+    EXPECT_TRUE(kodoc_file_encoder_open(
+        encoder_factory, "test_file_codes_missing.bin") == 0);
+
+    EXPECT_TRUE(kodoc_file_decoder_open(
+        decoder_factory, "test_file_codes_missing/file.bin", 100) == 0);
+
+    kodoc_delete_factory(encoder_factory);
+    kodoc_delete_factory(decoder_factory);
+}
+
+TEST(test_file_codes, missing_file)
+{
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+
+    test_combinations(test_missing_file, symbols, symbol_size);
+}
+
+#endif
@@ -0,0 +1,230 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <kodoc/kodoc.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "test_helper.hpp"
+
+static void test_object_codes(uint32_t symbols, uint32_t symbol_size,
+                              int32_t codec, int32_t finite_field)
+{
+    kodoc_factory_t encoder_factory =
+        kodoc_new_encoder_factory(codec, finite_field, symbols, symbol_size);
+
+    kodoc_factory_t decoder_factory =
+        kodoc_new_decoder_factory(codec, finite_field, symbols, symbol_size);
+
+    // Use an object that spans a few blocks and that typically ends with
+    // a partial symbol
+    uint64_t max_object_size = 5ULL * symbols * symbol_size;
+    uint64_t object_size = (rand() % max_object_size) + 1;
+    SCOPED_TRACE(testing::Message() << "object_size = " << object_size);
+
+    std::vector<uint8_t> data_in(object_size);
+    std::vector<uint8_t> data_out(object_size, 0);
+
+    for (auto& e : data_in)
+        e = rand() % 256;
+
+    kodoc_object_encoder_t encoder = kodoc_new_object_encoder(
+        encoder_factory, data_in.data(), object_size);
+
+    kodoc_object_decoder_t decoder = kodoc_new_object_decoder(
+        decoder_factory, data_out.data(), object_size);
+
+    uint32_t blocks = kodoc_object_encoder_blocks(encoder);
+    EXPECT_EQ(blocks, kodoc_object_decoder_blocks(decoder));
+    EXPECT_GT(blocks, 0U);
+    EXPECT_LE(blocks, 5U);
+
+    // The blocks must cover the object and be evenly sized
+    uint64_t total_symbols = 0;
+    uint32_t min_symbols = symbols;
+    uint32_t max_symbols = 0;
+
+    for (uint32_t i = 0; i < blocks; ++i)
+    {
+        uint32_t block_symbols = kodoc_object_encoder_block_symbols(encoder, i);
+        EXPECT_EQ(block_symbols,
+                  kodoc_object_decoder_block_symbols(decoder, i));
+        EXPECT_LE(block_symbols, symbols);
+
+        total_symbols += block_symbols;
+        min_symbols = std::min(min_symbols, block_symbols);
+        max_symbols = std::max(max_symbols, block_symbols);
+    }
+
+    EXPECT_EQ((object_size + symbol_size - 1) / symbol_size, total_symbols);
+    EXPECT_LE(max_symbols - min_symbols, 1U);
+
+    uint32_t payload_size = kodoc_object_encoder_payload_size(encoder);
+    EXPECT_EQ(payload_size, kodoc_object_decoder_payload_size(decoder));
+    EXPECT_GT(payload_size, kodoc_factory_max_payload_size(encoder_factory));
+
+    std::vector<uint8_t> payload(payload_size);
+
+    EXPECT_TRUE(kodoc_object_decoder_is_complete(decoder) == 0);
+
+    // Interleave the payloads of all blocks
+    uint32_t block = 0;
+    while (!kodoc_object_decoder_is_complete(decoder))
+    {
+        uint32_t bytes_used = kodoc_object_encoder_write_payload(
+            encoder, block, payload.data());
+        EXPECT_LE(bytes_used, payload_size);
+
+        EXPECT_EQ(block, kodoc_object_decoder_read_payload(
+            decoder, payload.data()));
+
+        block = (block + 1) % blocks;
+    }
+
+    for (uint32_t i = 0; i < blocks; ++i)
+    {
+        EXPECT_TRUE(kodoc_object_decoder_is_block_complete(decoder, i) != 0);
+        EXPECT_TRUE(kodoc_object_decoder_coder(decoder, i) == 0);
+    }
+
+    EXPECT_EQ(0, memcmp(data_in.data(), data_out.data(), object_size));
+
+    kodoc_delete_object_encoder(encoder);
+    kodoc_delete_object_decoder(decoder);
+
+    kodoc_delete_factory(encoder_factory);
+    kodoc_delete_factory(decoder_factory);
+}
+
+static void test_object_codes_iov(uint32_t symbols, uint32_t symbol_size,
+                                  int32_t codec, int32_t finite_field)
+{
+    kodoc_factory_t encoder_factory =
+        kodoc_new_encoder_factory(codec, finite_field, symbols, symbol_size);
+
+    kodoc_factory_t decoder_factory =
+        kodoc_new_decoder_factory(codec, finite_field, symbols, symbol_size);
+
+    uint64_t max_object_size = 3ULL * symbols * symbol_size;
+    uint64_t object_size = (rand() % max_object_size) + 1;
+    SCOPED_TRACE(testing::Message() << "object_size = " << object_size);
+
+    std::vector<uint8_t> data_in(object_size);
+    std::vector<uint8_t> data_out(object_size, 0);
+
+    for (auto& e : data_in)
+        e = rand() % 256;
+
+    kodoc_object_encoder_t encoder = kodoc_new_object_encoder(
+        encoder_factory, data_in.data(), object_size);
+
+    kodoc_object_decoder_t decoder = kodoc_new_object_decoder(
+        decoder_factory, data_out.data(), object_size);
+
+    uint32_t blocks = kodoc_object_encoder_blocks(encoder);
+    uint32_t payload_size = kodoc_object_encoder_payload_size(encoder);
+
+    std::vector<uint8_t> header(payload_size);
+    std::vector<uint8_t> payload(payload_size);
+
+    // The last block uses coded symbols only
+    uint32_t coded_block = blocks - 1;
+    kodoc_coder_t coded_encoder =
+        kodoc_object_encoder_coder(encoder, coded_block);
+
+    if (kodoc_has_systematic_interface(coded_encoder))
+        kodoc_set_systematic_off(coded_encoder);
+
+    for (uint32_t block = 0; block < blocks; ++block)
+    {
+        uint32_t block_symbols =
+            kodoc_object_encoder_block_symbols(encoder, block);
+        uint32_t sent = 0;
+
+        bool systematic = kodoc_has_systematic_interface(
+            kodoc_object_encoder_coder(encoder, block)) &&
+            block != coded_block;
+
+        while (!kodoc_object_decoder_is_block_complete(decoder, block))
+        {
+            kodoc_iovec_t iov[2];
+            uint32_t entries = kodoc_object_encoder_write_payload_iov(
+                encoder, block, header.data(), iov);
+
+            // The source symbols are referenced, not copied
+            if (systematic && sent < block_symbols)
+            {
+                ASSERT_EQ(2U, entries);
+                EXPECT_EQ(header.data(), iov[0].data);
+                EXPECT_EQ(symbol_size, iov[1].size);
+
+                bool partial = block + 1 == blocks &&
+                    object_size % symbol_size != 0 &&
+                    sent + 1 == block_symbols;
+
+                if (!partial)
+                {
+                    EXPECT_GE(iov[1].data, data_in.data());
+                    EXPECT_LT(iov[1].data, data_in.data() + object_size);
+                }
+            }
+            else
+            {
+                ASSERT_EQ(1U, entries);
+                EXPECT_EQ(header.data(), iov[0].data);
+            }
+
+            // Gather the entries like sendmsg() would
+            uint32_t size = 0;
+            for (uint32_t i = 0; i < entries; ++i)
+            {
+                ASSERT_LE(size + iov[i].size, payload_size);
+                memcpy(&payload[size], iov[i].data, iov[i].size);
+                size += iov[i].size;
+            }
+
+            EXPECT_EQ(block, kodoc_object_decoder_read_payload(
+                decoder, payload.data()));
+            ++sent;
+        }
+
+        // A systematic block is complete after its source symbols
+        if (systematic)
+        {
+            EXPECT_EQ(block_symbols, sent);
+        }
+    }
+
+    EXPECT_TRUE(kodoc_object_decoder_is_complete(decoder) != 0);
+    EXPECT_EQ(0, memcmp(data_in.data(), data_out.data(), object_size));
+
+    kodoc_delete_object_encoder(encoder);
+    kodoc_delete_object_decoder(decoder);
+
+    kodoc_delete_factory(encoder_factory);
+    kodoc_delete_factory(decoder_factory);
+}
+
+TEST(test_object_codes, encode_decode)
+{
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+
+    test_combinations(test_object_codes, symbols, symbol_size);
+}
+
+TEST(test_object_codes, encode_decode_iov)
+{
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+
+    test_combinations(test_object_codes_iov, symbols, symbol_size);
+}
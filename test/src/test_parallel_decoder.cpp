@@ -0,0 +1,141 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <kodoc/kodoc.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "test_helper.hpp"
+
+namespace
+{
+struct callback_context
+{
+    const uint8_t* m_data_in;
+    const uint8_t* m_data_out;
+    std::unique_ptr<std::atomic<uint32_t>[]> m_calls;
+    std::atomic<uint64_t> m_bytes;
+};
+
+void block_complete(uint32_t block, uint8_t* data, uint32_t size,
+                    void* context)
+{
+    auto c = (callback_context*) context;
+    ++c->m_calls[block];
+    c->m_bytes += size;
+
+    // The block must be decoded in place and be complete at this point
+    uint64_t offset = data - c->m_data_out;
+    EXPECT_EQ(0, memcmp(c->m_data_in + offset, data, size));
+}
+}
+
+static void test_parallel_decoder(uint32_t symbols, uint32_t symbol_size,
+                                  int32_t codec, int32_t finite_field)
+{
+    kodoc_factory_t encoder_factory =
+        kodoc_new_encoder_factory(codec, finite_field, symbols, symbol_size);
+
+    kodoc_factory_t decoder_factory =
+        kodoc_new_decoder_factory(codec, finite_field, symbols, symbol_size);
+
+    uint64_t max_object_size = 8ULL * symbols * symbol_size;
+    uint64_t object_size = (rand() % max_object_size) + 1;
+    SCOPED_TRACE(testing::Message() << "object_size = " << object_size);
+
+    std::vector<uint8_t> data_in(object_size);
+    std::vector<uint8_t> data_out(object_size, 0);
+
+    for (auto& e : data_in)
+        e = rand() % 256;
+
+    kodoc_object_encoder_t encoder = kodoc_new_object_encoder(
+        encoder_factory, data_in.data(), object_size);
+
+    uint32_t blocks = kodoc_object_encoder_blocks(encoder);
+
+    callback_context context;
+    context.m_data_in = data_in.data();
+    context.m_data_out = data_out.data();
+    context.m_calls.reset(new std::atomic<uint32_t>[blocks]);
+    context.m_bytes = 0;
+
+    for (uint32_t i = 0; i < blocks; ++i)
+        context.m_calls[i] = 0;
+
+    uint32_t threads = rand_nonzero(4);
+
+    kodoc_parallel_decoder_t decoder = kodoc_new_parallel_decoder(
+        decoder_factory, data_out.data(), object_size, threads, NULL,
+        block_complete, &context);
+
+    EXPECT_EQ(blocks, kodoc_parallel_decoder_blocks(decoder));
+    EXPECT_EQ(threads, kodoc_parallel_decoder_threads(decoder));
+
+    uint32_t payload_size = kodoc_object_encoder_payload_size(encoder);
+    EXPECT_EQ(payload_size, kodoc_parallel_decoder_payload_size(decoder));
+
+    std::vector<uint8_t> payload(payload_size);
+
+    uint32_t block = 0;
+    while (!kodoc_parallel_decoder_is_complete(decoder))
+    {
+        if (!kodoc_parallel_decoder_is_block_complete(decoder, block))
+        {
+            uint32_t bytes_used = kodoc_object_encoder_write_payload(
+                encoder, block, payload.data());
+
+            // A truncated payload cannot hold a symbol and is dropped
+            kodoc_parallel_decoder_read_payload(
+                decoder, payload.data(), rand() % (symbol_size + 4));
+
+            // A payload that can hold a symbol, but is truncated inside
+            // the coding coefficients or the seed, is also dropped
+            uint32_t min_size = 4 + symbol_size;
+            if (bytes_used > min_size)
+            {
+                kodoc_parallel_decoder_read_payload(
+                    decoder, payload.data(),
+                    min_size + rand() % (bytes_used - min_size));
+            }
+
+            kodoc_parallel_decoder_read_payload(
+                decoder, payload.data(), bytes_used);
+        }
+
+        block = (block + 1) % blocks;
+    }
+
+    kodoc_parallel_decoder_wait(decoder);
+    EXPECT_EQ(blocks, kodoc_parallel_decoder_completed_blocks(decoder));
+
+    // Every block is reported exactly once
+    for (uint32_t i = 0; i < blocks; ++i)
+        EXPECT_EQ(1U, context.m_calls[i].load());
+
+    EXPECT_EQ(object_size, context.m_bytes.load());
+    EXPECT_EQ(0, memcmp(data_in.data(), data_out.data(), object_size));
+
+    kodoc_delete_parallel_decoder(decoder);
+    kodoc_delete_object_encoder(encoder);
+
+    kodoc_delete_factory(encoder_factory);
+    kodoc_delete_factory(decoder_factory);
+}
+
+TEST(test_parallel_decoder, encode_decode)
+{
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+
+    test_combinations(test_parallel_decoder, symbols, symbol_size);
+}
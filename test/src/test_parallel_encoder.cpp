@@ -0,0 +1,86 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <kodoc/kodoc.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "test_helper.hpp"
+
+static void test_parallel_encoder(uint32_t symbols, uint32_t symbol_size,
+                                  int32_t codec, int32_t finite_field)
+{
+    kodoc_factory_t encoder_factory =
+        kodoc_new_encoder_factory(codec, finite_field, symbols, symbol_size);
+
+    kodoc_factory_t decoder_factory =
+        kodoc_new_decoder_factory(codec, finite_field, symbols, symbol_size);
+
+    uint64_t max_object_size = 8ULL * symbols * symbol_size;
+    uint64_t object_size = (rand() % max_object_size) + 1;
+    SCOPED_TRACE(testing::Message() << "object_size = " << object_size);
+
+    std::vector<uint8_t> data_in(object_size);
+    std::vector<uint8_t> data_out(object_size, 0);
+
+    for (auto& e : data_in)
+        e = rand() % 256;
+
+    uint32_t threads = rand_nonzero(4);
+    uint32_t ring_size = rand_nonzero(8);
+
+    kodoc_parallel_encoder_t encoder = kodoc_new_parallel_encoder(
+        encoder_factory, data_in.data(), object_size, ring_size, threads,
+        NULL);
+
+    kodoc_object_decoder_t decoder = kodoc_new_object_decoder(
+        decoder_factory, data_out.data(), object_size);
+
+    uint32_t blocks = kodoc_parallel_encoder_blocks(encoder);
+    EXPECT_EQ(blocks, kodoc_object_decoder_blocks(decoder));
+    EXPECT_EQ(threads, kodoc_parallel_encoder_threads(encoder));
+
+    uint32_t payload_size = kodoc_parallel_encoder_payload_size(encoder);
+    EXPECT_EQ(payload_size, kodoc_object_decoder_payload_size(decoder));
+
+    std::vector<uint8_t> payload(payload_size);
+
+    uint32_t block = 0;
+    while (!kodoc_object_decoder_is_complete(decoder))
+    {
+        if (!kodoc_object_decoder_is_block_complete(decoder, block))
+        {
+            uint32_t bytes_used = kodoc_parallel_encoder_write_payload(
+                encoder, block, payload.data());
+            EXPECT_LE(bytes_used, payload_size);
+
+            EXPECT_EQ(block, kodoc_object_decoder_read_payload(
+                decoder, payload.data()));
+        }
+
+        block = (block + 1) % blocks;
+    }
+
+    EXPECT_EQ(0, memcmp(data_in.data(), data_out.data(), object_size));
+
+    kodoc_delete_parallel_encoder(encoder);
+    kodoc_delete_object_decoder(decoder);
+
+    kodoc_delete_factory(encoder_factory);
+    kodoc_delete_factory(decoder_factory);
+}
+
+TEST(test_parallel_encoder, encode_decode)
+{
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+
+    test_combinations(test_parallel_encoder, symbols, symbol_size);
+}
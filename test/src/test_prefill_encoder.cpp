@@ -0,0 +1,89 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <kodoc/kodoc.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "test_helper.hpp"
+
+static void test_prefill_encoder(uint32_t symbols, uint32_t symbol_size,
+                                 int32_t codec, int32_t finite_field)
+{
+    kodoc_factory_t encoder_factory =
+        kodoc_new_encoder_factory(codec, finite_field, symbols, symbol_size);
+
+    kodoc_factory_t decoder_factory =
+        kodoc_new_decoder_factory(codec, finite_field, symbols, symbol_size);
+
+    kodoc_coder_t encoder = kodoc_factory_build_coder(encoder_factory);
+    kodoc_coder_t decoder = kodoc_factory_build_coder(decoder_factory);
+
+    uint32_t block_size = kodoc_block_size(encoder);
+    std::vector<uint8_t> data_in(block_size);
+    std::vector<uint8_t> data_out(block_size, 0);
+
+    for (auto& e : data_in)
+        e = rand() % 256;
+
+    kodoc_set_const_symbols(encoder, data_in.data(), block_size);
+    kodoc_set_mutable_symbols(decoder, data_out.data(), block_size);
+
+    uint32_t ring_size = rand_nonzero(8);
+
+    kodoc_prefill_encoder_t prefill =
+        kodoc_new_prefill_encoder(encoder, ring_size, NULL);
+
+    uint32_t payload_size = kodoc_prefill_encoder_payload_size(prefill);
+    EXPECT_EQ(kodoc_payload_size(encoder), payload_size);
+    EXPECT_LE(kodoc_prefill_encoder_ready(prefill), ring_size);
+
+    std::vector<uint8_t> payload(payload_size);
+
+    while (!kodoc_is_complete(decoder))
+    {
+        // Take the ready payloads without waiting, and fall back to the
+        // blocking call when the ring is empty
+        uint32_t bytes_used =
+            kodoc_prefill_encoder_try_write_payload(prefill, payload.data());
+
+        if (bytes_used == 0)
+        {
+            bytes_used =
+                kodoc_prefill_encoder_write_payload(prefill, payload.data());
+        }
+
+        EXPECT_GT(bytes_used, 0U);
+        EXPECT_LE(bytes_used, payload_size);
+
+        kodoc_read_payload(decoder, payload.data());
+    }
+
+    EXPECT_EQ(0, memcmp(data_in.data(), data_out.data(), block_size));
+
+    kodoc_delete_prefill_encoder(prefill);
+
+    // The encoder can be used directly again
+    EXPECT_GT(kodoc_write_payload(encoder, payload.data()), 0U);
+
+    kodoc_delete_coder(encoder);
+    kodoc_delete_coder(decoder);
+
+    kodoc_delete_factory(encoder_factory);
+    kodoc_delete_factory(decoder_factory);
+}
+
+TEST(test_prefill_encoder, encode_decode)
+{
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+
+    test_combinations(test_prefill_encoder, symbols, symbol_size);
+}
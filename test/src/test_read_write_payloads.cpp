@@ -0,0 +1,160 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <kodoc/kodoc.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "test_helper.hpp"
+
+static void test_write_payloads(uint32_t symbols, uint32_t symbol_size,
+                                int32_t codec, int32_t finite_field)
+{
+    kodoc_factory_t encoder_factory =
+        kodoc_new_encoder_factory(codec, finite_field, symbols, symbol_size);
+
+    kodoc_factory_t decoder_factory =
+        kodoc_new_decoder_factory(codec, finite_field, symbols, symbol_size);
+
+    kodoc_coder_t encoder = kodoc_factory_build_coder(encoder_factory);
+    kodoc_coder_t decoder = kodoc_factory_build_coder(decoder_factory);
+
+    uint32_t block_size = kodoc_block_size(encoder);
+    std::vector<uint8_t> data_in(block_size);
+    std::vector<uint8_t> data_out(block_size, 0);
+
+    for (auto& e : data_in)
+        e = rand() % 256;
+
+    kodoc_set_const_symbols(encoder, data_in.data(), block_size);
+    kodoc_set_mutable_symbols(decoder, data_out.data(), block_size);
+
+    // Use a stride that is larger than the payload size to verify that
+    // the payloads are placed at the correct offsets
+    uint32_t stride = kodoc_payload_size(encoder) + 3;
+    uint32_t count = symbols;
+
+    std::vector<uint8_t> buffer(stride * count);
+    std::vector<uint32_t> bytes_used(count);
+
+    while (!kodoc_is_complete(decoder))
+    {
+        uint64_t total = kodoc_write_payloads(
+            encoder, buffer.data(), stride, count, bytes_used.data());
+
+        uint64_t expected_total = 0;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            EXPECT_GT(bytes_used[i], 0U);
+            EXPECT_LE(bytes_used[i], kodoc_payload_size(encoder));
+            expected_total += bytes_used[i];
+        }
+        EXPECT_EQ(expected_total, total);
+
+        for (uint32_t i = 0; i < count && !kodoc_is_complete(decoder); ++i)
+        {
+            kodoc_read_payload(decoder, &buffer[i * stride]);
+        }
+    }
+
+    EXPECT_EQ(symbols, kodoc_rank(decoder));
+    EXPECT_EQ(0, memcmp(data_in.data(), data_out.data(), block_size));
+
+    // The bytes_used array is optional
+    EXPECT_GT(kodoc_write_payloads(encoder, buffer.data(), stride, 1, NULL),
+              0U);
+
+    kodoc_delete_coder(encoder);
+    kodoc_delete_coder(decoder);
+
+    kodoc_delete_factory(encoder_factory);
+    kodoc_delete_factory(decoder_factory);
+}
+
+static void test_read_payloads(uint32_t symbols, uint32_t symbol_size,
+                               int32_t codec, int32_t finite_field)
+{
+    kodoc_factory_t encoder_factory =
+        kodoc_new_encoder_factory(codec, finite_field, symbols, symbol_size);
+
+    kodoc_factory_t decoder_factory =
+        kodoc_new_decoder_factory(codec, finite_field, symbols, symbol_size);
+
+    kodoc_coder_t encoder = kodoc_factory_build_coder(encoder_factory);
+    kodoc_coder_t decoder = kodoc_factory_build_coder(decoder_factory);
+
+    uint32_t block_size = kodoc_block_size(encoder);
+    std::vector<uint8_t> data_in(block_size);
+    std::vector<uint8_t> data_out(block_size, 0);
+
+    for (auto& e : data_in)
+        e = rand() % 256;
+
+    kodoc_set_const_symbols(encoder, data_in.data(), block_size);
+    kodoc_set_mutable_symbols(decoder, data_out.data(), block_size);
+
+    uint32_t payload_size = kodoc_payload_size(encoder);
+    uint32_t count = symbols;
+
+    std::vector<uint8_t> buffer(payload_size * count);
+    std::vector<uint8_t*> payloads(count);
+
+    for (uint32_t i = 0; i < count; ++i)
+        payloads[i] = &buffer[i * payload_size];
+
+    // An empty batch should not change the decoder
+    EXPECT_EQ(0U, kodoc_read_payloads(decoder, payloads.data(), 0));
+    EXPECT_EQ(0U, kodoc_rank(decoder));
+
+    while (!kodoc_is_complete(decoder))
+    {
+        kodoc_write_payloads(encoder, buffer.data(), payload_size, count,
+                             NULL);
+
+        uint32_t used = kodoc_read_payloads(decoder, payloads.data(), count);
+        EXPECT_GT(used, 0U);
+        EXPECT_LE(used, count);
+
+        // The decoder should only stop early if it is complete
+        if (used < count)
+        {
+            EXPECT_TRUE(kodoc_is_complete(decoder) != 0);
+        }
+    }
+
+    EXPECT_EQ(symbols, kodoc_rank(decoder));
+    EXPECT_EQ(0, memcmp(data_in.data(), data_out.data(), block_size));
+
+    // A complete decoder should not consume any payloads
+    kodoc_write_payloads(encoder, buffer.data(), payload_size, count, NULL);
+    EXPECT_EQ(0U, kodoc_read_payloads(decoder, payloads.data(), count));
+
+    kodoc_delete_coder(encoder);
+    kodoc_delete_coder(decoder);
+
+    kodoc_delete_factory(encoder_factory);
+    kodoc_delete_factory(decoder_factory);
+}
+
+TEST(test_read_write_payloads, write_payloads)
+{
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+
+    test_combinations(test_write_payloads, symbols, symbol_size);
+}
+
+TEST(test_read_write_payloads, read_payloads)
+{
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+
+    test_combinations(test_read_payloads, symbols, symbol_size);
+}
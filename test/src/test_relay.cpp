@@ -0,0 +1,225 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#include <kodoc/kodoc.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "test_helper.hpp"
+
+// Forwards the source symbols of an encoder through a relay that can store
+// the entire generation, and decodes the recoded symbols
+static void test_relay_forward(uint32_t symbols, uint32_t symbol_size,
+                               int32_t finite_field)
+{
+    kodoc_factory_t encoder_factory = kodoc_new_encoder_factory(
+        kodoc_full_vector, finite_field, symbols, symbol_size);
+
+    kodoc_factory_t decoder_factory = kodoc_new_decoder_factory(
+        kodoc_full_vector, finite_field, symbols, symbol_size);
+
+    kodoc_coder_t encoder = kodoc_factory_build_coder(encoder_factory);
+    kodoc_coder_t decoder = kodoc_factory_build_coder(decoder_factory);
+
+    kodoc_relay_t relay =
+        kodoc_new_relay(finite_field, symbols, symbol_size, symbols);
+
+    EXPECT_EQ(symbols, kodoc_relay_symbols(relay));
+    EXPECT_EQ(symbol_size, kodoc_relay_symbol_size(relay));
+    EXPECT_EQ(symbols, kodoc_relay_max_buffered(relay));
+    EXPECT_EQ(kodoc_coefficient_vector_size(decoder),
+              kodoc_relay_coefficient_vector_size(relay));
+    // The coefficients are stored once as received and once in echelon form
+    uint32_t vector_size = kodoc_coefficient_vector_size(decoder);
+    EXPECT_EQ(symbols * (symbol_size + 2 * vector_size),
+              kodoc_relay_memory_size(relay));
+
+    uint32_t block_size = kodoc_block_size(encoder);
+    std::vector<uint8_t> data_in(block_size);
+    std::vector<uint8_t> data_out(block_size, 0);
+
+    for (auto& e : data_in)
+        e = rand() % 256;
+
+    kodoc_set_const_symbols(encoder, data_in.data(), block_size);
+    kodoc_set_mutable_symbols(decoder, data_out.data(), block_size);
+
+    std::vector<uint8_t> symbol(symbol_size);
+    std::vector<uint8_t> coefficients(
+        kodoc_relay_coefficient_vector_size(relay));
+
+    // Nothing can be recoded before a symbol is received
+    EXPECT_EQ(0U, kodoc_relay_write_symbol(
+        relay, symbol.data(), coefficients.data()));
+
+    for (uint32_t i = 0; i < symbols; ++i)
+    {
+        kodoc_write_uncoded_symbol(encoder, symbol.data(), i);
+        kodoc_relay_read_uncoded_symbol(relay, symbol.data(), i);
+    }
+
+    EXPECT_EQ(symbols, kodoc_relay_buffered(relay));
+    EXPECT_EQ(symbols, kodoc_relay_received(relay));
+
+    // The relay holds the full generation, so the decoder completes after
+    // a few recoded symbols more than the generation size
+    uint32_t recoded = 0;
+    while (!kodoc_is_complete(decoder) && recoded < 100 * symbols)
+    {
+        EXPECT_EQ(symbol_size, kodoc_relay_write_symbol(
+            relay, symbol.data(), coefficients.data()));
+        kodoc_read_symbol(decoder, symbol.data(), coefficients.data());
+        ++recoded;
+    }
+
+    EXPECT_TRUE(kodoc_is_complete(decoder) != 0);
+    EXPECT_EQ(0, memcmp(data_in.data(), data_out.data(), block_size));
+
+    kodoc_relay_reset(relay);
+    EXPECT_EQ(0U, kodoc_relay_buffered(relay));
+    EXPECT_EQ(0U, kodoc_relay_received(relay));
+
+    kodoc_delete_relay(relay);
+
+    kodoc_delete_coder(encoder);
+    kodoc_delete_coder(decoder);
+
+    kodoc_delete_factory(encoder_factory);
+    kodoc_delete_factory(decoder_factory);
+}
+
+// Passes more coded symbols through a relay than it can store, and checks
+// that the memory budget is respected and that the rank of the relay is
+// forwarded in full
+static void test_relay_budget(uint32_t symbols, uint32_t symbol_size,
+                              int32_t finite_field, uint32_t max_buffered)
+{
+    kodoc_factory_t encoder_factory = kodoc_new_encoder_factory(
+        kodoc_full_vector, finite_field, symbols, symbol_size);
+
+    kodoc_factory_t decoder_factory = kodoc_new_decoder_factory(
+        kodoc_full_vector, finite_field, symbols, symbol_size);
+
+    kodoc_coder_t encoder = kodoc_factory_build_coder(encoder_factory);
+    kodoc_coder_t decoder = kodoc_factory_build_coder(decoder_factory);
+
+    kodoc_relay_t relay =
+        kodoc_new_relay(finite_field, symbols, symbol_size, max_buffered);
+
+    uint32_t block_size = kodoc_block_size(encoder);
+    std::vector<uint8_t> data_in(block_size);
+    std::vector<uint8_t> data_out(block_size, 0);
+
+    for (auto& e : data_in)
+        e = rand() % 256;
+
+    kodoc_set_const_symbols(encoder, data_in.data(), block_size);
+    kodoc_set_mutable_symbols(decoder, data_out.data(), block_size);
+
+    std::vector<uint8_t> symbol(symbol_size);
+    std::vector<uint8_t> coefficients(kodoc_coefficient_vector_size(encoder));
+
+    // The relay is filled, and then receives more symbols than it can
+    // store, which must not reduce its rank
+    uint32_t received = 0;
+    uint32_t extra = 0;
+    while (extra <= max_buffered && received < 100 * symbols)
+    {
+        for (auto& c : coefficients)
+            c = rand() % 256;
+
+        // Clear the unused bits in the last byte of the packed fields
+        if (finite_field == kodoc_binary4 && symbols % 2)
+            coefficients.back() &= 0x0F;
+        if (finite_field == kodoc_binary && symbols % 8)
+            coefficients.back() &= (1U << (symbols % 8)) - 1;
+
+        kodoc_write_symbol(encoder, symbol.data(), coefficients.data());
+        kodoc_relay_read_symbol(relay, symbol.data(), coefficients.data());
+        ++received;
+
+        EXPECT_LE(kodoc_relay_buffered(relay), max_buffered);
+
+        if (kodoc_relay_buffered(relay) == max_buffered)
+            ++extra;
+    }
+
+    EXPECT_EQ(max_buffered, kodoc_relay_buffered(relay));
+
+    // The decoder gets exactly the degrees of freedom that the relay stores
+    uint32_t recoded = 0;
+    while (kodoc_rank(decoder) < max_buffered && recoded < 100 * symbols)
+    {
+        kodoc_relay_write_symbol(relay, symbol.data(), coefficients.data());
+        kodoc_read_symbol(decoder, symbol.data(), coefficients.data());
+        ++recoded;
+    }
+
+    EXPECT_EQ(max_buffered, kodoc_rank(decoder));
+
+    if (max_buffered == symbols)
+    {
+        EXPECT_TRUE(kodoc_is_complete(decoder) != 0);
+        EXPECT_EQ(0, memcmp(data_in.data(), data_out.data(), block_size));
+    }
+
+    kodoc_delete_relay(relay);
+
+    kodoc_delete_coder(encoder);
+    kodoc_delete_coder(decoder);
+
+    kodoc_delete_factory(encoder_factory);
+    kodoc_delete_factory(decoder_factory);
+}
+
+TEST(test_relay, forward)
+{
+    if (kodoc_has_codec(kodoc_full_vector) == false)
+        return;
+
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+
+    test_relay_forward(symbols, symbol_size, kodoc_binary);
+    test_relay_forward(symbols, symbol_size, kodoc_binary4);
+    test_relay_forward(symbols, symbol_size, kodoc_binary8);
+}
+
+TEST(test_relay, budget)
+{
+    if (kodoc_has_codec(kodoc_full_vector) == false)
+        return;
+
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+
+    uint32_t max_buffered = rand_nonzero(symbols);
+
+    test_relay_budget(symbols, symbol_size, kodoc_binary, max_buffered);
+    test_relay_budget(symbols, symbol_size, kodoc_binary4, max_buffered);
+    test_relay_budget(symbols, symbol_size, kodoc_binary8, max_buffered);
+}
+
+TEST(test_relay, full_rank)
+{
+    if (kodoc_has_codec(kodoc_full_vector) == false)
+        return;
+
+    uint32_t symbol_size = rand_symbol_size();
+
+    // A full relay that keeps receiving symbols forwards the generation
+    test_relay_budget(40, symbol_size, kodoc_binary, 40);
+
+    uint32_t symbols = rand_symbols();
+
+    test_relay_budget(symbols, symbol_size, kodoc_binary, symbols);
+    test_relay_budget(symbols, symbol_size, kodoc_binary4, symbols);
+    test_relay_budget(symbols, symbol_size, kodoc_binary8, symbols);
+}
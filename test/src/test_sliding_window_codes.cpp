@@ -143,8 +143,13 @@ void test_sliding_window(uint32_t max_symbols, uint32_t max_symbol_size,
     EXPECT_EQ(memcmp(data_in, data_out, block_size), 0);
 
     // Check that the trace functions were called at least once
+#if !defined(KODOC_DISABLE_TRACE)
     EXPECT_GT(encoder_trace_called, 0U);
     EXPECT_GT(decoder_trace_called, 0U);
+#else
+    EXPECT_EQ(0U, encoder_trace_called);
+    EXPECT_EQ(0U, decoder_trace_called);
+#endif
 
     free(data_in);
     free(data_out);
@@ -0,0 +1,94 @@
+// Copyright Steinwurf ApS 2016.
+// Distributed under the "STEINWURF RESEARCH LICENSE 1.0".
+// See accompanying file LICENSE.rst or
+// http://www.steinwurf.com/licensing
+
+#if !defined(KODOC_DISABLE_RLNC) && !defined(KODOC_DISABLE_FULL_VECTOR)
+
+#include <kodoc/kodoc.h>
+#include <kodoc/kodoc.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "test_helper.hpp"
+
+// A copy would share the coding state of the original
+static_assert(!std::is_copy_constructible<
+    kodoc::encoder<kodoc::codec::full_vector, kodoc::field::binary>>::value,
+    "The typed coders must not be copyable");
+static_assert(!std::is_copy_assignable<
+    kodoc::decoder<kodoc::codec::full_vector, kodoc::field::binary>>::value,
+    "The typed coders must not be copyable");
+
+template<class Field>
+static void test_typed_api(uint32_t symbols, uint32_t symbol_size,
+                           int32_t finite_field)
+{
+    kodoc::encoder<kodoc::codec::full_vector, Field> encoder(
+        symbols, symbol_size);
+    kodoc::decoder<kodoc::codec::full_vector, Field> decoder(
+        symbols, symbol_size);
+
+    EXPECT_EQ(symbols, encoder.symbols());
+    EXPECT_EQ(symbol_size, encoder.symbol_size());
+    EXPECT_EQ(symbols * symbol_size, decoder.block_size());
+
+    // The typed coders use the same stacks as the C API
+    kodoc_factory_t encoder_factory = kodoc_new_encoder_factory(
+        kodoc_full_vector, finite_field, symbols, symbol_size);
+    kodoc_coder_t c_encoder = kodoc_factory_build_coder(encoder_factory);
+
+    EXPECT_EQ(kodoc_payload_size(c_encoder), encoder.payload_size());
+    EXPECT_EQ(kodoc_coefficient_vector_size(c_encoder),
+              encoder.coefficient_vector_size());
+
+    kodoc_delete_coder(c_encoder);
+    kodoc_delete_factory(encoder_factory);
+
+    uint32_t block_size = encoder.block_size();
+    std::vector<uint8_t> data_in(block_size);
+    std::vector<uint8_t> data_out(block_size, 0);
+
+    for (auto& e : data_in)
+        e = rand() % 256;
+
+    encoder.set_const_symbols(data_in.data(), block_size);
+    decoder.set_mutable_symbols(data_out.data(), block_size);
+
+    EXPECT_TRUE(encoder.is_systematic_on());
+    encoder.set_systematic_off();
+    EXPECT_FALSE(encoder.is_systematic_on());
+
+    std::vector<uint8_t> payload(encoder.payload_size());
+
+    while (!decoder.is_complete())
+    {
+        EXPECT_GT(encoder.write_payload(payload.data()), 0U);
+        decoder.read_payload(payload.data());
+    }
+
+    EXPECT_EQ(symbols, decoder.rank());
+    EXPECT_EQ(symbols, decoder.symbols_uncoded());
+    EXPECT_EQ(0, memcmp(data_in.data(), data_out.data(), block_size));
+}
+
+TEST(test_typed_api, full_vector)
+{
+    uint32_t symbols = rand_symbols();
+    uint32_t symbol_size = rand_symbol_size();
+
+    test_typed_api<kodoc::field::binary>(
+        symbols, symbol_size, kodoc_binary);
+    test_typed_api<kodoc::field::binary4>(
+        symbols, symbol_size, kodoc_binary4);
+    test_typed_api<kodoc::field::binary8>(
+        symbols, symbol_size, kodoc_binary8);
+}
+
+#endif